@@ -0,0 +1,480 @@
+#ifndef MONEY_CHRISTOFIDES
+#define MONEY_CHRISTOFIDES
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "csr_graph.h"
+#include "edge_weights.h"
+#include "priority_queue.h"
+#include "weighted_matching.h"
+
+/**
+ * Christofides' construction of a Hamiltonian circuit from a minimum
+ * spanning tree: match up the tree's odd-degree vertices, so that the
+ * tree plus the matching has only even degrees, walk an Eulerian
+ * circuit of that multigraph, and shortcut the walk by listing each
+ * vertex only when it is first reached. With a minimum-weight perfect
+ * matching on a graph whose weights obey the triangle inequality the
+ * circuit is at most 1.5 times the optimum, against twice for
+ * TwiceAround.
+ *
+ * EXACT matches with WeightedMatching, Edmonds' blossom algorithm, on
+ * the complete graph over the odd vertices: O(k^3) time and O(k^2)
+ * memory for k odd vertices, so above EXACT_LIMIT odd vertices it
+ * falls back to GREEDY, and get_matching says which ran. Two odd
+ * vertices the EdgeWeights lookup does not join cost the length of the
+ * shortest path between them in the graph, found by Dijkstra's
+ * algorithm from each odd vertex that has such a pair.
+ *
+ * GREEDY sorts the graph's edges between odd vertices by weight and
+ * takes each one whose ends are both still free, O(E log E). The
+ * vertices left over, which only a graph that is not complete can
+ * leave, have no edge between any two of them. They are matched in
+ * rounds along shortest paths: Dijkstra's algorithm grows a region
+ * from every one of them at once, each edge between two regions gives
+ * a path between their sources, and the paths are taken greedily,
+ * cheapest first, O(E log E) a round. Any still left then, each in a
+ * part of the graph with no other, are paired in index order. It
+ * carries no guarantee; on random Euclidean graphs its matching comes
+ * out about a fifth heavier than the exact one and the circuit about
+ * five percent longer.
+ *
+ * A matched pair the lookup does not join is walked along its path,
+ * whose edges all go into the multigraph, so every step of the
+ * Eulerian circuit is an edge of the graph and the matching's weight
+ * is the weight of the edges it adds.
+ *
+ * A tree on V vertices typically has a third or more of them at odd
+ * degree, so any input much past a few thousand vertices, and every
+ * input of around 10^5, runs GREEDY whatever was asked for: the
+ * circuit is then not within the 1.5 bound.
+ *
+ * The Eulerian circuit comes from Hierholzer's algorithm with an
+ * explicit stack and one cursor per vertex into its edges, so it takes
+ * O(V) on the tree plus matching. Weights of the matching and of the
+ * circuit's steps come from an EdgeWeights lookup; the shortcut steps
+ * of a graph that is not complete need not be edges of it, and a
+ * missing one adds nothing to the circuit's length; compute reports
+ * whether there was one. If the
+ * tree is a forest each remaining part gets its own circuit, joined in
+ * the order of their lowest vertices.
+ *
+ * A basic operation is one edge scanned by the matching or a shortest
+ * path search, one heap level moved, one edge followed by the Eulerian
+ * walk or one weight looked up.
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+class Christofides
+{
+ public:
+  enum class Matching { EXACT, GREEDY };
+
+  static constexpr size_t EXACT_LIMIT = 1024;
+
+  /**
+   * Construct an engine
+   * @param matching how to match the odd-degree vertices
+   */
+  explicit Christofides( Matching matching = Matching::EXACT )
+    : matching{ matching }, used{ matching }, odd_count{ 0 }, length{ 0 },
+      matching_weight{ 0 }, op_count{ 0 } {}
+
+  /**
+   * Build the circuit of a tree
+   * @param graph the graph, every edge in both directions
+   * @param mst its minimum spanning tree, every edge in both directions
+   * @param weights the weight lookup of the graph
+   * @param start the vertex the circuit starts and ends at
+   * @param circuit set to the vertices in order, start repeated last
+   * @return true if every pair matched is joined by a path and every
+   *         step of the circuit is an edge of the graph
+   */
+  bool compute( const CSRGraph & graph, const CSRGraph & mst,
+                EdgeWeights & weights, uint start,
+                std::vector< uint > & circuit )
+  {
+    size_t vertices = mst.size();
+    circuit.clear();
+    length = 0;
+    matching_weight = 0;
+    op_count = 0;
+    if( vertices == 0 )
+      return true;
+
+    std::vector< uint > odd;
+    for( size_t v = 0; v < vertices; v++ )
+    {
+      if( mst.degree( v ) % 2 == 1 )
+        odd.push_back( v );
+    }
+    odd_count = odd.size();
+    used = odd.size() > EXACT_LIMIT ? Matching::GREEDY : matching;
+    // the matching's edges, a pair with no edge as its path's edges
+    std::vector< std::pair< uint, uint > > pairs;
+    if( used == Matching::EXACT )
+      match_exact( graph, odd, weights, pairs );
+    else
+      match_greedy( graph, odd, pairs );
+
+    bool complete = true;
+    for( auto & pair : pairs )
+    {
+      op_count++;
+      uint weight = weights.get( pair.first, pair.second );
+      if( weight == EdgeWeights::ABSENT )
+        complete = false;
+      else
+        matching_weight += weight;
+    }
+
+    // the tree plus the matching, each edge once, stored at both ends
+    std::vector< std::pair< uint, uint > > edges( pairs );
+    for( size_t v = 0; v < vertices; v++ )
+    {
+      for( size_t e = mst.begin( v ); e < mst.begin( v + 1 ); e++ )
+      {
+        if( v < mst.target( e ) )
+          edges.push_back( { uint( v ), mst.target( e ) } );
+      }
+    }
+    std::vector< size_t > offsets( vertices + 1, 0 );
+    for( auto & edge : edges )
+    {
+      offsets[ edge.first + 1 ]++;
+      offsets[ edge.second + 1 ]++;
+    }
+    for( size_t v = 0; v < vertices; v++ )
+    {
+      offsets[ v + 1 ] += offsets[ v ];
+    }
+    std::vector< size_t > cursor( offsets.begin(), offsets.end() - 1 );
+    std::vector< uint > incident( offsets.back() );
+    for( size_t e = 0; e < edges.size(); e++ )
+    {
+      incident[ cursor[ edges[ e ].first ]++ ] = e;
+      incident[ cursor[ edges[ e ].second ]++ ] = e;
+    }
+    cursor.assign( offsets.begin(), offsets.end() - 1 );
+
+    // Hierholzer's walk from each part in turn, shortcut as it ends
+    std::vector< bool > followed( edges.size(), false );
+    std::vector< bool > visited( vertices, false );
+    std::vector< uint > stack;
+    std::vector< uint > walk;
+    circuit.reserve( vertices + 1 );
+    for( size_t root = start, count = 0; count < vertices;
+         root = ( root + 1 ) % vertices, count++ )
+    {
+      if( visited[ root ] )
+        continue;
+      walk.clear();
+      stack.push_back( root );
+      while( !stack.empty() )
+      {
+        uint vertex = stack.back();
+        while( cursor[ vertex ] < offsets[ vertex + 1 ]
+               && followed[ incident[ cursor[ vertex ] ] ] )
+          cursor[ vertex ]++;
+        if( cursor[ vertex ] == offsets[ vertex + 1 ] )
+        {
+          walk.push_back( vertex );
+          stack.pop_back();
+          continue;
+        }
+        op_count++;
+        uint e = incident[ cursor[ vertex ]++ ];
+        followed[ e ] = true;
+        stack.push_back( edges[ e ].first == vertex ? edges[ e ].second
+                         : edges[ e ].first );
+      }
+      for( auto it = walk.rbegin(); it != walk.rend(); it++ )
+      {
+        if( !visited[ *it ] )
+        {
+          visited[ *it ] = true;
+          circuit.push_back( *it );
+        }
+      }
+    }
+    circuit.push_back( start );
+
+    for( size_t i = 0; i + 1 < circuit.size(); i++ )
+    {
+      // only a one-vertex circuit steps from a vertex to itself
+      if( circuit[ i ] == circuit[ i + 1 ] )
+        continue;
+      op_count++;
+      uint weight = weights.get( circuit[ i ], circuit[ i + 1 ] );
+      if( weight == EdgeWeights::ABSENT )
+        complete = false;
+      else
+        length += weight;
+    }
+    return complete;
+  }
+
+  /**
+   * Accessor for the matching the last computation used, which is
+   * GREEDY if EXACT was asked for but there were too many odd vertices
+   * @return the matching used
+   */
+  Matching get_matching() const
+  {
+    return used;
+  }
+
+  /**
+   * Accessor for the number of odd-degree vertices of the last tree
+   * @return the odd vertex count
+   */
+  size_t get_odd_count() const
+  {
+    return odd_count;
+  }
+
+  /**
+   * Accessor for the weight of the last matching
+   * @return the sum of the weights of the edges it added, along the
+   *         path of any pair not joined by an edge
+   */
+  uint64_t get_matching_weight() const
+  {
+    return matching_weight;
+  }
+
+  /**
+   * Accessor for the length of the last circuit built
+   * @return the sum of the weights of its steps
+   */
+  uint64_t get_length() const
+  {
+    return length;
+  }
+
+  /**
+   * Accessor for the basic operations of the last computation
+   * @return the count of basic operations
+   */
+  size_t get_op_count() const
+  {
+    return op_count;
+  }
+
+ private:
+  static constexpr uint NONE = UINT_MAX;
+
+  Matching matching;
+  Matching used;
+  size_t odd_count;
+  uint64_t length;
+  uint64_t matching_weight;
+  size_t op_count;
+  std::vector< uint > source;   // the nearest source of each vertex
+  std::vector< uint > distance; // the distance to it
+  std::vector< uint > previous; // the vertex before on the path to it
+
+  /**
+   * Dijkstra's algorithm from every source at once: each vertex reached
+   * gets its nearest source, the distance to it, capped below NONE, and
+   * the vertex before it on the path; the others get NONE
+   */
+  void grow( const CSRGraph & graph, const std::vector< uint > & sources )
+  {
+    source.assign( graph.size(), NONE );
+    distance.assign( graph.size(), NONE );
+    previous.assign( graph.size(), NONE );
+    std::vector< bool > known( graph.size(), false );
+    IndexedPQ queue( graph.size() );
+    for( uint s : sources )
+    {
+      source[ s ] = s;
+      distance[ s ] = 0;
+      queue.insert( s, 0 );
+    }
+    while( !queue.is_empty() )
+    {
+      uint vertex = queue.remove();
+      known[ vertex ] = true;
+      for( size_t e = graph.begin( vertex ); e < graph.begin( vertex + 1 );
+           e++ )
+      {
+        op_count++;
+        uint next = graph.target( e );
+        uint64_t through = uint64_t( distance[ vertex ] ) + graph.weight( e );
+        uint key = through < NONE ? uint( through ) : NONE - 1;
+        if( !known[ next ] && queue.insert_or_decrease( next, key ) )
+        {
+          source[ next ] = source[ vertex ];
+          distance[ next ] = key;
+          previous[ next ] = vertex;
+        }
+      }
+    }
+    op_count += queue.get_op_count();
+  }
+
+  /**
+   * Add the edges of the path grow found from a vertex back to its source
+   */
+  void add_path( uint vertex, std::vector< std::pair< uint, uint > > & pairs )
+  {
+    for( ; previous[ vertex ] != NONE; vertex = previous[ vertex ] )
+    {
+      pairs.push_back( { previous[ vertex ], vertex } );
+    }
+  }
+
+  /**
+   * A minimum-weight perfect matching of the odd vertices, as the
+   * maximum-weight matching under C - w
+   */
+  void match_exact( const CSRGraph & graph, const std::vector< uint > & odd,
+                    EdgeWeights & weights,
+                    std::vector< std::pair< uint, uint > > & pairs )
+  {
+    size_t k = odd.size();
+    std::vector< int64_t > cost( k * k, 0 );
+    std::vector< bool > joined( k * k, true );
+    for( size_t i = 0; i < k; i++ )
+    {
+      bool searched = false;
+      for( size_t j = i + 1; j < k; j++ )
+      {
+        cost[ i * k + j ] = weights.get( odd[ i ], odd[ j ] );
+        if( cost[ i * k + j ] != EdgeWeights::ABSENT )
+          continue;
+        joined[ i * k + j ] = false;
+        if( !searched )
+          grow( graph, { odd[ i ] } );
+        searched = true;
+        cost[ i * k + j ] = distance[ odd[ j ] ] == NONE
+          ? EdgeWeights::ABSENT : distance[ odd[ j ] ];
+      }
+    }
+    int64_t heaviest = 0;
+    for( size_t i = 0; i < k * k; i++ )
+    {
+      heaviest = std::max( heaviest, cost[ i ] );
+    }
+    int64_t ceiling = int64_t( k / 2 + 1 ) * heaviest + 1;
+    WeightedMatching solver( k );
+    for( size_t i = 0; i < k; i++ )
+    {
+      for( size_t j = i + 1; j < k; j++ )
+      {
+        solver.set_weight( i, j, ceiling - cost[ i * k + j ] );
+      }
+    }
+    solver.compute();
+    op_count += solver.get_op_count();
+    for( size_t i = 0; i < k; i++ )
+    {
+      uint mate = solver.get_mate( i );
+      if( mate == WeightedMatching::NONE || mate < i )
+        continue;
+      if( !joined[ i * k + mate ] )
+        grow( graph, { odd[ i ] } );
+      if( !joined[ i * k + mate ] && distance[ odd[ mate ] ] != NONE )
+        add_path( odd[ mate ], pairs );
+      else
+        pairs.push_back( { odd[ i ], odd[ mate ] } );
+    }
+  }
+
+  /**
+   * Match the odd vertices along the graph's lightest edges first
+   */
+  void match_greedy( const CSRGraph & graph, const std::vector< uint > & odd,
+                     std::vector< std::pair< uint, uint > > & pairs )
+  {
+    std::vector< bool > free( graph.size(), false );
+    for( uint v : odd )
+    {
+      free[ v ] = true;
+    }
+    std::vector< std::pair< uint, std::pair< uint, uint > > > candidates;
+    for( uint v : odd )
+    {
+      for( size_t e = graph.begin( v ); e < graph.begin( v + 1 ); e++ )
+      {
+        op_count++;
+        uint target = graph.target( e );
+        if( v < target && free[ target ] )
+          candidates.push_back( { graph.weight( e ), { v, target } } );
+      }
+    }
+    std::sort( candidates.begin(), candidates.end() );
+    for( auto & candidate : candidates )
+    {
+      uint a = candidate.second.first;
+      uint b = candidate.second.second;
+      if( free[ a ] && free[ b ] )
+      {
+        free[ a ] = false;
+        free[ b ] = false;
+        pairs.push_back( { a, b } );
+      }
+    }
+
+    // the vertices left over share no edge, or the loop above would
+    // have matched them, so match them along shortest paths in rounds
+    std::vector< uint > left;
+    for( uint v : odd )
+    {
+      if( free[ v ] )
+        left.push_back( v );
+    }
+    while( left.size() > 1 )
+    {
+      grow( graph, left );
+      std::vector< std::pair< uint64_t, std::pair< uint, uint > > > paths;
+      for( uint v = 0; v < graph.size(); v++ )
+      {
+        if( source[ v ] == NONE )
+          continue;
+        for( size_t e = graph.begin( v ); e < graph.begin( v + 1 ); e++ )
+        {
+          op_count++;
+          uint target = graph.target( e );
+          if( source[ target ] != NONE && source[ v ] < source[ target ] )
+            paths.push_back( { uint64_t( distance[ v ] ) + graph.weight( e )
+                               + distance[ target ], { v, target } } );
+        }
+      }
+      std::sort( paths.begin(), paths.end() );
+      size_t matched = 0;
+      for( auto & path : paths )
+      {
+        uint v = path.second.first;
+        uint target = path.second.second;
+        if( free[ source[ v ] ] && free[ source[ target ] ] )
+        {
+          free[ source[ v ] ] = false;
+          free[ source[ target ] ] = false;
+          add_path( v, pairs );
+          pairs.push_back( { v, target } );
+          add_path( target, pairs );
+          matched++;
+        }
+      }
+      if( matched == 0 )
+        break;
+      left.erase( std::remove_if( left.begin(), left.end(),
+                                  [ &free ]( uint v ) { return !free[ v ]; } ),
+                  left.end() );
+    }
+
+    // any still left have no path to another
+    for( size_t i = 0; i + 1 < left.size(); i += 2 )
+    {
+      pairs.push_back( { left[ i ], left[ i + 1 ] } );
+    }
+  }
+};
+
+#endif
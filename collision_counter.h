@@ -0,0 +1,265 @@
+#ifndef MONEY_COLLISION_COUNTER
+#define MONEY_COLLISION_COUNTER
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include "hash_functions.h"
+#include "key_file.h"
+
+/**
+ * A callable hash function and the name it is reported under
+ */
+template< typename Hash >
+struct NamedCallable
+{
+  const char * name;
+  Hash function;
+};
+
+/**
+ * Counts first-slot collisions, the measure hashing_collisions.cpp has
+ * always printed: a key collides when its slot is already occupied.
+ * Tables are sized at run time, from a load factor when the number of
+ * keys is known, and occupancy is one bit per slot instead of a size_t
+ * per slot, so testing at production scale takes 1/64th the memory
+ * and lives on the heap.
+ *
+ * A whole key file can be added with several threads. The file is cut
+ * into line-aligned chunks, many more than there are threads, which the
+ * threads claim in turn; each thread hashes its chunks with every
+ * function into bitsets of its own, and the bitsets are then ORed
+ * together a word range per thread. A key collides exactly when it is
+ * not the first key in its slot, so the collisions of a function are
+ * the keys minus the occupied slots, whatever order the keys came in:
+ * the parallel counts are identical to adding the keys one at a time.
+ *
+ * The functions are NamedHash function pointers for CollisionCounter.
+ * A function that carries state, such as a perfect hash to look keys up
+ * in, is counted by a BasicCollisionCounter of NamedCallable instead,
+ * which calls the callable directly rather than through a wrapper.
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+template< typename Function >
+class BasicCollisionCounter
+{
+ public:
+  /**
+   * The table size that holds keys at the given load factor
+   * @param keys the number of keys
+   * @param load_factor keys per slot, greater than zero
+   * @return the table size, at least 1
+   */
+  static size_t table_size_for( size_t keys, double load_factor )
+  {
+    size_t slots = size_t( std::ceil( keys / load_factor ) );
+    return slots > 0 ? slots : 1;
+  }
+
+  /**
+   * Construct a counter with one table per function
+   * @param functions the hash functions to count collisions for
+   * @param table_size the number of slots in each table
+   * @param threads the number of threads add may use for a key file
+   */
+  BasicCollisionCounter( const std::vector< Function > & functions,
+                         size_t table_size, unsigned threads = 1 )
+    : functions{ functions }, table_size{ table_size },
+      threads{ threads > 0 ? threads : 1 },
+      occupied( functions.size(), Bitset( words(), 0 ) ),
+      collision_counts( functions.size(), 0 ), key_count{ 0 } {}
+
+  /**
+   * Hash one key with every function and count any collisions
+   * @param key the key to add
+   */
+  void add( const std::string & key )
+  {
+    for( size_t f = 0; f < functions.size(); f++ )
+    {
+      size_t slot = functions[ f ].function( key, table_size );
+      uint64_t & word = occupied[ f ][ slot / 64 ];
+      uint64_t bit = uint64_t( 1 ) << ( slot % 64 );
+      if( word & bit )
+        collision_counts[ f ]++;
+      else
+        word |= bit;
+    }
+    key_count++;
+  }
+
+  /**
+   * Hash every key of a file with every function and count collisions,
+   * using as many threads as the counter was constructed with
+   * @param keys the key file
+   */
+  void add( const KeyFile & keys )
+  {
+    if( threads == 1 )
+    {
+      keys.for_each( [ this ]( const std::string & key ) { add( key ); } );
+      return;
+    }
+
+    // thread 0 marks the counter's own bitsets; the others allocate
+    // theirs on their own threads so the pages are local to them
+    std::vector< size_t > bounds = keys.split( threads * 16 );
+    std::atomic< size_t > next_chunk{ 0 };
+    std::vector< std::vector< Bitset > > marks( threads - 1 );
+    std::vector< size_t > added( threads, 0 );
+    std::vector< std::thread > pool;
+
+    for( unsigned t = 0; t < threads; t++ )
+    {
+      pool.emplace_back( [ this, &keys, &bounds, &next_chunk, &marks,
+                           &added, t ]()
+                         {
+                           if( t > 0 )
+                             marks[ t - 1 ].assign( functions.size(),
+                                                    Bitset( words(), 0 ) );
+                           std::vector< Bitset > & mine =
+                             t == 0 ? occupied : marks[ t - 1 ];
+                           size_t keys_added = 0;
+                           for( size_t chunk = next_chunk++;
+                                chunk + 1 < bounds.size();
+                                chunk = next_chunk++ )
+                           {
+                             keys.for_each( bounds[ chunk ],
+                                            bounds[ chunk + 1 ],
+                                            [ this, &mine, &keys_added ](
+                                              const std::string & key )
+                                            {
+                                              mark( mine, key );
+                                              keys_added++;
+                                            } );
+                           }
+                           added[ t ] = keys_added;
+                         } );
+    }
+    for( unsigned t = 0; t < threads; t++ )
+    {
+      pool[ t ].join();
+      key_count += added[ t ];
+    }
+    pool.clear();
+
+    // OR every thread's bitsets into the counter's and count the
+    // occupied slots, one word range per thread
+    size_t range = ( words() + threads - 1 ) / threads;
+    std::vector< std::vector< size_t > > occupied_slots(
+      threads, std::vector< size_t >( functions.size(), 0 ) );
+    for( unsigned t = 0; t < threads; t++ )
+    {
+      pool.emplace_back( [ this, &marks, &occupied_slots, t, range ]()
+                         {
+                           size_t begin = std::min( words(), t * range );
+                           size_t end = std::min( words(), begin + range );
+                           for( size_t f = 0; f < functions.size(); f++ )
+                           {
+                             size_t slots = 0;
+                             for( size_t w = begin; w < end; w++ )
+                             {
+                               uint64_t word = occupied[ f ][ w ];
+                               for( auto & other : marks )
+                               {
+                                 word |= other[ f ][ w ];
+                               }
+                               occupied[ f ][ w ] = word;
+                               slots += __builtin_popcountll( word );
+                             }
+                             occupied_slots[ t ][ f ] = slots;
+                           }
+                         } );
+    }
+    for( unsigned t = 0; t < threads; t++ )
+    {
+      pool[ t ].join();
+    }
+    for( size_t f = 0; f < functions.size(); f++ )
+    {
+      size_t slots = 0;
+      for( unsigned t = 0; t < threads; t++ )
+      {
+        slots += occupied_slots[ t ][ f ];
+      }
+      collision_counts[ f ] = key_count - slots;
+    }
+  }
+
+  /**
+   * Accessor for the collisions of one function
+   * @param function the index of the function
+   * @return the number of keys that landed in an occupied slot
+   */
+  size_t collisions( size_t function ) const
+  {
+    return collision_counts[ function ];
+  }
+
+  /**
+   * Accessor for the number of keys added
+   * @return the key count
+   */
+  size_t size() const
+  {
+    return key_count;
+  }
+
+  /**
+   * Accessor for the number of slots in each table
+   * @return the table size
+   */
+  size_t get_table_size() const
+  {
+    return table_size;
+  }
+
+  /**
+   * Accessor for the functions being counted
+   * @return the functions, in index order
+   */
+  const std::vector< Function > & get_functions() const
+  {
+    return functions;
+  }
+
+ private:
+  typedef std::vector< uint64_t > Bitset;
+
+  std::vector< Function > functions;
+  size_t table_size;
+  unsigned threads;
+  std::vector< Bitset > occupied; // one per function
+  std::vector< size_t > collision_counts;
+  size_t key_count;
+
+  /**
+   * The number of 64-bit words in each bitset
+   */
+  size_t words() const
+  {
+    return ( table_size + 63 ) / 64;
+  }
+
+  /**
+   * Mark the slot of key for every function, without counting
+   */
+  void mark( std::vector< Bitset > & bitsets, const std::string & key ) const
+  {
+    for( size_t f = 0; f < functions.size(); f++ )
+    {
+      size_t slot = functions[ f ].function( key, table_size );
+      bitsets[ f ][ slot / 64 ] |= uint64_t( 1 ) << ( slot % 64 );
+    }
+  }
+};
+
+typedef BasicCollisionCounter< NamedHash > CollisionCounter;
+
+#endif
@@ -0,0 +1,344 @@
+#ifndef MONEY_CONCURRENT_HASH_SET
+#define MONEY_CONCURRENT_HASH_SET
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+/**
+ * An open-addressing hash set that many threads may insert into and
+ * query at once, templated on a hash function with the signature of
+ * hash_320 so any function from hash_functions.h plugs in.
+ *
+ * Every slot is one atomic word: empty, or a pointer to an immutable
+ * node holding the key and its mixed hash. insert claims an empty slot
+ * with a single compare-and-swap and contains only loads, so neither
+ * takes a lock and a thread that stalls never blocks the others.
+ * Slots are probed linearly and are never emptied again, so two
+ * threads inserting the same key always meet on the same probe
+ * sequence and exactly one of them reports it as new.
+ *
+ * When a table passes 3/4 load a table of twice the size is chained
+ * after it and every thread that notices helps migrate: slots are
+ * claimed 256 at a time, each is frozen by setting the low bit of its
+ * word (an empty slot becomes MOVED) and its node is copied into the
+ * new table. Fresh inserts go to the new table only once every slot is
+ * frozen, so a key inserted into the old table before its slot froze is
+ * always seen there. Waiting for the last chunk of a migration is the
+ * one place a thread can wait on another. Retired tables are kept until
+ * the set is destroyed, since a reader may still be probing them; they
+ * add at most the current table's size again.
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+template< typename Key, size_t ( *Hash )( const Key &, size_t ) >
+class ConcurrentHashSet
+{
+ public:
+  /**
+   * Construct an empty set
+   * @param expected the number of keys to make room for
+   */
+  explicit ConcurrentHashSet( size_t expected = 0 )
+  {
+    size_t wanted = MIN_CAPACITY;
+    while( wanted / 4 * 3 < expected )
+      wanted *= 2;
+    oldest = new Table( wanted );
+    current.store( oldest );
+  }
+
+  ConcurrentHashSet( const ConcurrentHashSet & ) = delete;
+  ConcurrentHashSet & operator=( const ConcurrentHashSet & ) = delete;
+
+  /**
+   * The destructor frees every node and table; no other thread may be
+   * using the set
+   */
+  ~ConcurrentHashSet()
+  {
+    Table * last = oldest;
+    while( last->next.load() != nullptr )
+      last = last->next.load();
+    for( size_t i = 0; i < last->capacity; i++ )
+    {
+      uintptr_t value = last->slots[ i ].load();
+      if( value != EMPTY && value != MOVED )
+        delete node_of( value );
+    }
+    while( oldest != nullptr )
+    {
+      Table * next = oldest->next.load();
+      delete oldest;
+      oldest = next;
+    }
+  }
+
+  /**
+   * Insert a key if it is not already present
+   * @param key the key to insert
+   * @return true if inserted, false if the key was already present
+   */
+  bool insert( const Key & key )
+  {
+    size_t hash = mix( Hash( key, SIZE_MAX ) );
+    Node * node = nullptr;
+    Table * table = current.load( std::memory_order_acquire );
+
+    while( true )
+    {
+      if( table->next.load( std::memory_order_acquire ) != nullptr )
+      {
+        table = migrate( table );
+        continue;
+      }
+      switch( insert_into( table, hash, key, node ) )
+      {
+        case INSERTED:
+          if( table->count.fetch_add( 1, std::memory_order_relaxed ) + 1
+              > table->capacity / 4 * 3 )
+            grow( table );
+          return true;
+        case PRESENT:
+          delete node;
+          return false;
+        case FROZEN:
+          grow( table );
+          break;
+      }
+    }
+  }
+
+  /**
+   * Accessor to determine whether a key is present
+   * @param key the key to look for
+   * @return true if the key has been inserted
+   */
+  bool contains( const Key & key ) const
+  {
+    size_t hash = mix( Hash( key, SIZE_MAX ) );
+    const Table * table = current.load( std::memory_order_acquire );
+
+    while( true )
+    {
+      size_t mask = table->capacity - 1;
+      size_t slot = hash & mask;
+      size_t probes = 0;
+      for( ; probes < table->capacity; probes++, slot = ( slot + 1 ) & mask )
+      {
+        uintptr_t value = table->slots[ slot ].load(
+          std::memory_order_acquire );
+        if( value == EMPTY )
+          return false;
+        if( value == MOVED )
+          break;
+        const Node * node = node_of( value );
+        if( node->hash == hash && node->key == key )
+          return true;
+      }
+      table = table->next.load( std::memory_order_acquire );
+      if( table == nullptr )
+        return false;
+    }
+  }
+
+  /**
+   * Accessor for the number of keys; exact when no insert is running
+   * @return the number of keys
+   */
+  size_t size() const
+  {
+    const Table * table = current.load( std::memory_order_acquire );
+    while( table->next.load( std::memory_order_acquire ) != nullptr )
+      table = table->next.load( std::memory_order_acquire );
+    return table->count.load( std::memory_order_relaxed );
+  }
+
+  /**
+   * Accessor to determine whether the set is empty
+   * @return true if no key has been inserted
+   */
+  bool is_empty() const
+  {
+    return size() == 0;
+  }
+
+  /**
+   * Accessor for the number of slots in the newest table
+   * @return the capacity
+   */
+  size_t get_capacity() const
+  {
+    const Table * table = current.load( std::memory_order_acquire );
+    while( table->next.load( std::memory_order_acquire ) != nullptr )
+      table = table->next.load( std::memory_order_acquire );
+    return table->capacity;
+  }
+
+ private:
+  static constexpr size_t MIN_CAPACITY = 64;
+  static constexpr size_t MIGRATION_CHUNK = 256;
+  static constexpr uintptr_t EMPTY = 0;
+  static constexpr uintptr_t MOVED = 1; // an empty slot that was frozen
+
+  enum Outcome { INSERTED, PRESENT, FROZEN };
+
+  struct Node
+  {
+    size_t hash;
+    Key key;
+  };
+
+  struct Table
+  {
+    explicit Table( size_t capacity )
+      : capacity{ capacity },
+        slots{ new std::atomic< uintptr_t >[ capacity ] }, count{ 0 },
+        next{ nullptr }, claimed{ 0 }, migrated{ 0 }
+    {
+      for( size_t i = 0; i < capacity; i++ )
+      {
+        slots[ i ].store( EMPTY, std::memory_order_relaxed );
+      }
+    }
+
+    ~Table()
+    {
+      delete[] slots;
+    }
+
+    size_t capacity; // a power of two
+    std::atomic< uintptr_t > * slots;
+    alignas( 64 ) std::atomic< size_t > count;
+    alignas( 64 ) std::atomic< Table * > next;
+    std::atomic< size_t > claimed;  // slots handed out to migrate
+    std::atomic< size_t > migrated; // slots frozen and copied
+  };
+
+  Table * oldest;
+  alignas( 64 ) std::atomic< Table * > current;
+
+  /**
+   * Spread the bits of a hash value with a 64-bit multiplicative mix
+   */
+  static size_t mix( size_t hash )
+  {
+    uint64_t mixed = uint64_t( hash ) * 0x9e3779b97f4a7c15ull;
+    return size_t( mixed ^ ( mixed >> 32 ) );
+  }
+
+  static Node * node_of( uintptr_t value )
+  {
+    return reinterpret_cast< Node * >( value & ~uintptr_t( 1 ) );
+  }
+
+  /**
+   * Probe one table for key and claim the first empty slot with a CAS,
+   * allocating the node the first time one is needed
+   * @return FROZEN if the probe reached a frozen empty slot or a full
+   *         table, so the key belongs in the next table
+   */
+  Outcome insert_into( Table * table, size_t hash, const Key & key,
+                       Node *& node )
+  {
+    size_t mask = table->capacity - 1;
+    size_t slot = hash & mask;
+    for( size_t probes = 0; probes < table->capacity;
+         probes++, slot = ( slot + 1 ) & mask )
+    {
+      uintptr_t value = table->slots[ slot ].load( std::memory_order_acquire );
+      while( value == EMPTY )
+      {
+        if( node == nullptr )
+          node = new Node{ hash, key };
+        if( table->slots[ slot ].compare_exchange_weak(
+              value, reinterpret_cast< uintptr_t >( node ),
+              std::memory_order_acq_rel, std::memory_order_acquire ) )
+          return INSERTED;
+      }
+      if( value == MOVED )
+        return FROZEN;
+      const Node * other = node_of( value );
+      if( other->hash == hash && other->key == key )
+        return PRESENT;
+    }
+    return FROZEN;
+  }
+
+  /**
+   * Chain a table of twice the size after table, unless another thread
+   * already has, and help migrate into it
+   */
+  void grow( Table * table )
+  {
+    if( table->next.load( std::memory_order_acquire ) == nullptr )
+    {
+      Table * bigger = new Table( table->capacity * 2 );
+      Table * expected = nullptr;
+      if( !table->next.compare_exchange_strong( expected, bigger,
+                                                std::memory_order_acq_rel ) )
+        delete bigger;
+    }
+    migrate( table );
+  }
+
+  /**
+   * Freeze and copy chunks of table's slots until none are left, wait
+   * for the other helpers to finish theirs, then advance current
+   * @return the table after table, now holding every key
+   */
+  Table * migrate( Table * table )
+  {
+    Table * next = table->next.load( std::memory_order_acquire );
+    size_t start;
+    while( ( start = table->claimed.fetch_add( MIGRATION_CHUNK ) )
+           < table->capacity )
+    {
+      size_t end = std::min( table->capacity, start + MIGRATION_CHUNK );
+      size_t copied = 0;
+      for( size_t i = start; i < end; i++ )
+      {
+        uintptr_t value = table->slots[ i ].load( std::memory_order_acquire );
+        while( value == EMPTY &&
+               !table->slots[ i ].compare_exchange_weak(
+                 value, MOVED, std::memory_order_acq_rel ) ) {}
+        if( value == EMPTY )
+          continue;
+        // only this thread migrates slot i, so the node cannot change
+        table->slots[ i ].store( value | 1, std::memory_order_release );
+        copy_into( next, node_of( value ) );
+        copied++;
+      }
+      next->count.fetch_add( copied, std::memory_order_relaxed );
+      table->migrated.fetch_add( end - start, std::memory_order_release );
+    }
+    while( table->migrated.load( std::memory_order_acquire ) < table->capacity )
+      std::this_thread::yield();
+
+    Table * expected = table;
+    current.compare_exchange_strong( expected, next,
+                                     std::memory_order_acq_rel );
+    return next;
+  }
+
+  /**
+   * Place a migrating node in the first empty slot of its probe
+   * sequence; keys in one table are distinct, so no comparison is needed
+   */
+  static void copy_into( Table * table, Node * node )
+  {
+    size_t mask = table->capacity - 1;
+    uintptr_t pointer = reinterpret_cast< uintptr_t >( node );
+    for( size_t slot = node->hash & mask; ; slot = ( slot + 1 ) & mask )
+    {
+      uintptr_t expected = EMPTY;
+      if( table->slots[ slot ].compare_exchange_strong(
+            expected, pointer, std::memory_order_acq_rel ) )
+        return;
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,159 @@
+/**
+ * contention benchmark for ConcurrentHashSet
+ *
+ * builds a stream of random keys drawn from a smaller set of distinct
+ * keys, as a deduplicating ingestion service sees them, then for 1, 2,
+ * 4, ... up to the maximum thread count splits the stream between the
+ * threads, which insert it into one shared set starting from its
+ * smallest table, so the growth runs under contention too. It reports
+ * the insert throughput and then the throughput of looking every key
+ * up again, in millions of operations per second, and checks that
+ * exactly one insert of each distinct key reported it as new. Both
+ * hash_320 and custom_hash_320 are run
+ *
+ * usage: concurrent_hash_set_bench [operations] [distinct keys]
+ *                                  [max threads]
+ *
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "concurrent_hash_set.h"
+#include "hash_functions.h"
+
+using namespace std;
+
+/**
+ * Time the inserts and lookups of the keys with the given thread count
+ * and print one result line
+ * @param name the name of the hash function
+ * @param keys the key stream
+ * @param distinct the number of distinct keys in the stream
+ * @param threads the number of threads
+ * @return true if every distinct key was reported new exactly once
+ */
+template< size_t ( *Hash )( const string &, size_t ) >
+bool run( const string & name, const vector< string > & keys,
+          size_t distinct, unsigned threads );
+
+/**
+ * Run body( t ) on threads threads at once and time them
+ * @return the elapsed seconds
+ */
+template< typename Body >
+double timed( unsigned threads, Body body );
+
+int main( int argc, char * argv[] )
+{
+  size_t operations = argc > 1 ? strtoul( argv[ 1 ], nullptr, 10 ) : 4000000;
+  size_t universe = argc > 2 ? strtoul( argv[ 2 ], nullptr, 10 ) : 1000000;
+  unsigned max_threads = argc > 3 ? strtoul( argv[ 3 ], nullptr, 10 ) : 64;
+
+  // a pool of distinct words, then a stream that repeats them
+  mt19937_64 generator( 320 );
+  uniform_int_distribution< int > length( 4, 16 );
+  uniform_int_distribution< int > letter( 'a', 'z' );
+  vector< string > pool;
+  unordered_set< string > seen;
+  while( pool.size() < max< size_t >( universe, 1 ) )
+  {
+    string word( length( generator ), ' ' );
+    for( auto & character : word )
+    {
+      character = letter( generator );
+    }
+    if( seen.insert( word ).second )
+      pool.push_back( word );
+  }
+  uniform_int_distribution< size_t > pick( 0, pool.size() - 1 );
+  vector< string > keys;
+  seen.clear();
+  for( size_t i = 0; i < operations; i++ )
+  {
+    keys.push_back( pool[ pick( generator ) ] );
+    seen.insert( keys.back() );
+  }
+
+  cout << "operations: " << operations << ", distinct keys: " << seen.size()
+       << ", hardware threads: " << thread::hardware_concurrency() << endl;
+  cout << left << setw( 18 ) << "function" << setw( 9 ) << "threads"
+       << setw( 16 ) << "insert Mops/s" << setw( 18 ) << "contains Mops/s"
+       << "capacity" << endl;
+  bool valid = true;
+  for( unsigned threads = 1; threads <= max_threads; threads *= 2 )
+  {
+    valid &= run< hash_320 >( "hash_320", keys, seen.size(), threads );
+    valid &= run< custom_hash_320 >( "custom_hash_320", keys, seen.size(),
+                                     threads );
+  }
+  return valid ? 0 : 1;
+}
+
+template< size_t ( *Hash )( const string &, size_t ) >
+bool run( const string & name, const vector< string > & keys,
+          size_t distinct, unsigned threads )
+{
+  ConcurrentHashSet< string, Hash > set;
+  size_t chunk = ( keys.size() + threads - 1 ) / threads;
+  atomic< size_t > inserted{ 0 };
+  atomic< size_t > found{ 0 };
+
+  double insert_seconds = timed( threads, [ & ]( unsigned t )
+    {
+      size_t begin = min( keys.size(), t * chunk );
+      size_t end = min( keys.size(), begin + chunk );
+      size_t mine = 0;
+      for( size_t i = begin; i < end; i++ )
+      {
+        mine += set.insert( keys[ i ] );
+      }
+      inserted += mine;
+    } );
+  double contains_seconds = timed( threads, [ & ]( unsigned t )
+    {
+      size_t begin = min( keys.size(), t * chunk );
+      size_t end = min( keys.size(), begin + chunk );
+      size_t mine = 0;
+      for( size_t i = begin; i < end; i++ )
+      {
+        mine += set.contains( keys[ i ] );
+      }
+      found += mine;
+    } );
+
+  bool valid = inserted == distinct && set.size() == distinct
+    && found == keys.size();
+  cout << left << setw( 18 ) << name << setw( 9 ) << threads << fixed
+       << setprecision( 2 ) << setw( 16 ) << keys.size() / insert_seconds / 1e6
+       << setw( 18 ) << keys.size() / contains_seconds / 1e6
+       << set.get_capacity() << ( valid ? "" : "  INVALID" ) << endl;
+  return valid;
+}
+
+template< typename Body >
+double timed( unsigned threads, Body body )
+{
+  vector< thread > pool;
+  auto start = chrono::steady_clock::now();
+  for( unsigned t = 0; t < threads; t++ )
+  {
+    pool.emplace_back( body, t );
+  }
+  for( auto & worker : pool )
+  {
+    worker.join();
+  }
+  chrono::duration< double > elapsed = chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
@@ -1,5 +1,20 @@
 /**
- * brute-force convex hull algorithm from Levitin chapter 3
+ * brute-force convex hull algorithm from Levitin chapter 3, plus the
+ * O(n log n) ConvexHull engine from convex_hull.h
+ *
+ * usage: convex_hull [brute | monotone | quickhull | stream] [threads]
+ *                    [--text | --int32 | --int64 file] [--examined]
+ * the default is monotone; brute runs the original O(n^3) algorithm
+ * so its basic-op count can be compared against the engine's, and with
+ * --examined also prints to cerr the points its kernel examined. with a
+ * thread count above 1 the engine splits the points into per-thread
+ * chunks and merges the local hulls; the output is the same.
+ * stream never stores the input: each point goes straight into an
+ * IncrementalHull, and the hull vertices are printed in
+ * counter-clockwise order instead of input order
+ *
+ * input comes from cin unless a file is named: --text memory-maps a
+ * text file, --int32 and --int64 memory-map packed binary (x, y) pairs
  *
  * input: space-separated pairs of integer coordinates on the x-y plane,
  * one pair per line
@@ -15,8 +30,15 @@
 
 #include <cassert>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <string>
 #include <vector>
+#include "convex_hull.h"
+#include "hull_kernels.h"
+#include "incremental_hull.h"
+#include "point_io.h"
 
 using namespace std;
 
@@ -25,41 +47,124 @@ using namespace std;
  * function proceeds to test every combination of two points, forming a 
  * line segment to see if there are any points outside of the line. If
  * there are none, it will store those points in the convex hull point
- * vector
+ * vector. The sign counting for each line runs in the vectorized
+ * count_signs kernel, which stops once it has seen both sides. A basic
+ * operation is still one point of the original inner loop, n per
+ * pair, so the count stays comparable with the O(n^3) baseline; the
+ * points the kernel actually examined are counted separately
  * @param xcoords stores the x values in a vector
  * @param ycoords stores the y values in a vector
  * @param chpoints stores the points that are in the convex hull
+ * @param pointsExamined is set to the points the kernel examined
+ * @return the basic operation count
  */
 uint find_convex_hull( const vector< int > & xcoords,
                        const vector< int > & ycoords,
-                       vector< bool > & chpoints );
+                       vector< bool > & chpoints, uint & pointsExamined );
 
-int main()
+/**
+ * Reads points one at a time into an incremental hull, so memory is
+ * proportional to the hull size, then prints the hull vertices in
+ * counter-clockwise order in the usual output format
+ * @param path the text file to read, or empty to read cin
+ * @return 0, or 1 if the input could not be read
+ */
+int stream_convex_hull( const string & path );
+
+int main( int argc, char * argv[] )
 {
+  bool brute_force = false;
+  bool stream = false;
+  ConvexHull::Algorithm algorithm = ConvexHull::Algorithm::MONOTONE_CHAIN;
+  unsigned threads = 1;
+  string format;
+  string path;
+  bool examined = false;
+
+  int positional = 0;
+  for( int arg = 1; arg < argc; arg++ )
+  {
+    if( strcmp( argv[ arg ], "--examined" ) == 0 )
+    {
+      examined = true;
+    }
+    else if( strncmp( argv[ arg ], "--", 2 ) == 0 && arg + 1 < argc )
+    {
+      format = argv[ arg ] + 2;
+      path = argv[ ++arg ];
+    }
+    else if( positional++ == 0 )
+    {
+      if( strcmp( argv[ arg ], "brute" ) == 0 )
+        brute_force = true;
+      else if( strcmp( argv[ arg ], "stream" ) == 0 )
+        stream = true;
+      else if( strcmp( argv[ arg ], "quickhull" ) == 0 )
+        algorithm = ConvexHull::Algorithm::QUICKHULL;
+      else if( strcmp( argv[ arg ], "monotone" ) != 0 )
+        positional = 3;
+    }
+    else
+    {
+      threads = strtoul( argv[ arg ], nullptr, 10 );
+    }
+  }
+  if( positional > 2 || ( format != "" && format != "text"
+                          && format != "int32" && format != "int64" )
+      || ( stream && format != "" && format != "text" ) )
+  {
+    cerr << "usage: " << argv[ 0 ]
+         << " [brute | monotone | quickhull | stream] [threads]"
+         << " [--text | --int32 | --int64 file] [--examined]" << endl;
+    return 1;
+  }
+  if( stream )
+    return stream_convex_hull( path );
+
   vector< int > xcoords; // the x-coordinates
   vector< int > ycoords; // the y-coordinates
 
   uint basicOps = 0;
 
-  uint n = 0;
-  while( ! cin.eof() )
+  bool loaded;
+  if( format == "int32" )
+    loaded = load_binary_points< int32_t >( path, xcoords, ycoords );
+  else if( format == "int64" )
+    loaded = load_binary_points< int64_t >( path, xcoords, ycoords );
+  else if( format == "text" )
+    loaded = load_text_points( path, xcoords, ycoords );
+  else
+    loaded = read_text_points( stdin, xcoords, ycoords );
+  if( !loaded )
   {
-    int value;
-    if( cin >> value && ! cin.eof() )
-    {
-      xcoords.push_back( value );
-      cin >> value;
-      ycoords.push_back( value );
-      n++;
-    }
+    cerr << "cannot read points from " << ( path == "" ? "stdin" : path )
+         << endl;
+    return 1;
   }
+  uint n = xcoords.size();
 
   // a boolean array that states whether the point is in the convex
   // hull or not. start with all points not in the hull
   vector< bool > chpoints( xcoords.size(), false );
 
   // determine the convex hull
-  basicOps = find_convex_hull( xcoords, ycoords, chpoints );
+  if( n == 0 )
+  {
+    basicOps = 0;
+  }
+  else if( brute_force )
+  {
+    uint pointsExamined = 0;
+    basicOps = find_convex_hull( xcoords, ycoords, chpoints,
+                                 pointsExamined );
+    if( examined )
+      cerr << "points examined: " << pointsExamined << endl;
+  }
+  else
+  {
+    ConvexHull engine( algorithm, threads );
+    basicOps = engine.compute( xcoords, ycoords, chpoints );
+  }
 
   // print the points that make up the convex hull
   for( uint i = 0; i < chpoints.size(); i++ )
@@ -73,9 +178,10 @@ int main()
 
 uint find_convex_hull( const vector< int > & xcoords,
                        const vector< int > & ycoords,
-                       vector< bool > & chpoints )
+                       vector< bool > & chpoints, uint & pointsExamined )
 {
   uint basicOpCount = 0;
+  pointsExamined = 0;
   assert( xcoords.size() > 0 );
 
   if( xcoords.size() == 1 )
@@ -93,31 +199,18 @@ uint find_convex_hull( const vector< int > & xcoords,
     {
       for( uint point2 = point1 + 1; point2 < xcoords.size(); point2++ )
       {
-        int a_coeff = ycoords.at( point2 ) - ycoords.at( point1 );
-        int b_coeff = xcoords.at( point1 ) - xcoords.at( point2 );
-        int c_coeff = xcoords.at( point1 ) * ycoords.at( point2 ) -
-          xcoords.at( point2 ) * ycoords.at( point1 );
-        
-        uint positives = 0; // count the number of points with positive sign
-        uint negatives = 0; // and with negative sign
-        for( uint point3 = 0; point3 < xcoords.size(); point3++ )
-        {
-	  basicOpCount++;
-          if( point3 != point1 && point3 != point2 )
-          {
-            int signvalue = a_coeff * xcoords.at( point3 ) + 
-              b_coeff * ycoords.at( point3 ) - c_coeff;
-            if( signvalue < 0 )
-            {
-              negatives++;
-            }
-            else if( signvalue > 0 )
-            {
-              positives++;
-            }
-          }
-        }
-        
+        // count the points on each side of the line through point1 and
+        // point2, stopping as soon as both sides are seen. point1 and
+        // point2 themselves lie on the line and count on neither side
+        SignCounts counts = count_signs( xcoords[ point1 ], ycoords[ point1 ],
+                                         xcoords[ point2 ], ycoords[ point2 ],
+                                         xcoords.data(), ycoords.data(),
+                                         xcoords.size() );
+        basicOpCount += xcoords.size();
+        pointsExamined += counts.examined;
+        uint positives = counts.positives;
+        uint negatives = counts.negatives;
+
         if( positives == 0 || negatives == 0 )
         {
           chpoints.at( point1 ) = chpoints.at( point2 ) = true;
@@ -127,3 +220,41 @@ uint find_convex_hull( const vector< int > & xcoords,
   }
   return basicOpCount;
 }
+
+int stream_convex_hull( const string & path )
+{
+  IncrementalHull< int > hull;
+  auto insert = [ &hull ]( int x, int y )
+    {
+      hull.insert( x, y );
+    };
+
+  bool loaded = false;
+  if( path == "" )
+  {
+    loaded = scan_points< int >( stdin, insert );
+  }
+  else
+  {
+    MappedFile file( path );
+    loaded = file.is_open();
+    scan_points< int >( file.data(), file.data() + file.size(), true,
+                        insert, loaded );
+  }
+  if( !loaded )
+  {
+    cerr << "cannot read points from " << ( path == "" ? "stdin" : path )
+         << endl;
+    return 1;
+  }
+
+  if( !hull.is_empty() )
+  {
+    for( auto & vertex : hull.hull() )
+    {
+      cout << vertex.first << ',' << vertex.second << ' ';
+    }
+  }
+  cout << endl << hull.size() << "\t" << hull.get_op_count() << endl;
+  return 0;
+}
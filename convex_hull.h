@@ -0,0 +1,388 @@
+#ifndef MONEY_CONVEX_HULL
+#define MONEY_CONVEX_HULL
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "orientation.h"
+
+/**
+ * An O(n log n) convex hull engine with two interchangeable backends:
+ * Andrew's monotone chain and QuickHull. Like the brute-force
+ * find_convex_hull it fills a vector< bool > marking every input point
+ * that lies on the hull boundary and counts basic operations (one per
+ * orientation test), but it also keeps the hull vertices in
+ * counter-clockwise order. Coordinates may be any integer or floating
+ * point type; every turn is decided by the exact predicates in
+ * orientation.h, so large coordinates cannot overflow the hull.
+ *
+ * With more than one thread the points are split into one contiguous
+ * chunk per thread, each thread computes the hull of its chunk with the
+ * chosen algorithm, the hull of the union of the local hull vertices is
+ * the hull of all points, and the boundary marking is split the same way.
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+template< typename Coord >
+class BasicConvexHull
+{
+ public:
+  /**
+   * The algorithms the engine can run
+   */
+  enum class Algorithm { MONOTONE_CHAIN, QUICKHULL };
+
+  /**
+   * Construct an engine using the given algorithm
+   * @param algorithm the backend used by compute
+   * @param threads the number of threads compute may use
+   */
+  explicit BasicConvexHull( Algorithm algorithm = Algorithm::MONOTONE_CHAIN,
+                            unsigned threads = 1 )
+    : algorithm{ algorithm }, threads{ threads > 0 ? threads : 1 },
+      op_count{ 0 } {}
+
+  /**
+   * Compute the convex hull of the points. Every point on the hull
+   * boundary, including points in the middle of a hull edge, is marked
+   * true in chpoints, matching the brute-force contract.
+   * @param xcoords stores the x values in a vector
+   * @param ycoords stores the y values in a vector
+   * @param chpoints stores the points that are in the convex hull
+   * @return the number of basic operations performed
+   */
+  uint compute( const std::vector< Coord > & xcoords,
+                const std::vector< Coord > & ycoords,
+                std::vector< bool > & chpoints )
+  {
+    assert( xcoords.size() > 0 );
+    assert( xcoords.size() == ycoords.size() );
+    assert( chpoints.size() == xcoords.size() );
+
+    xs = &xcoords;
+    ys = &ycoords;
+    op_count = 0;
+    hull.clear();
+
+    if( threads > 1 && xcoords.size() > threads )
+    {
+      parallel_hull( chpoints );
+    }
+    else
+    {
+      std::vector< size_t > order( xcoords.size() );
+      for( size_t i = 0; i < order.size(); i++ )
+      {
+        order[ i ] = i;
+      }
+      local_hull( order );
+      mark_boundary( chpoints, 0, chpoints.size() );
+    }
+    return op_count;
+  }
+
+  /**
+   * Accessor for the indices of the hull vertices from the last call to
+   * compute, in counter-clockwise order starting with the lowest
+   * leftmost point. Points in the middle of an edge are not vertices.
+   * @return the hull vertex indices
+   */
+  const std::vector< size_t > & get_hull() const
+  {
+    return hull;
+  }
+
+  /**
+   * Return the number of basic operations counted by the last compute
+   * @return the count of basic operations
+   */
+  size_t get_op_count() const
+  {
+    return op_count;
+  }
+
+ private:
+  Algorithm algorithm;
+  unsigned threads;
+  size_t op_count;
+  std::vector< size_t > hull;
+  const std::vector< Coord > * xs = nullptr;
+  const std::vector< Coord > * ys = nullptr;
+
+  /**
+   * The turn made by points a, b, c: 1 for counter-clockwise, -1 for
+   * clockwise and 0 for collinear. Counts as one basic operation.
+   */
+  int orient( size_t a, size_t b, size_t c )
+  {
+    op_count++;
+    return orientation( ( *xs )[ a ], ( *ys )[ a ], ( *xs )[ b ], ( *ys )[ b ],
+                        ( *xs )[ c ], ( *ys )[ c ] );
+  }
+
+  /**
+   * Twice the signed area of triangle a, b, c. Counts as one basic
+   * operation.
+   */
+  auto area( size_t a, size_t b, size_t c )
+  {
+    op_count++;
+    return twice_area( ( *xs )[ a ], ( *ys )[ a ], ( *xs )[ b ], ( *ys )[ b ],
+                       ( *xs )[ c ], ( *ys )[ c ] );
+  }
+
+  /**
+   * Sort point indices by x, then by y
+   * @param order the indices to sort
+   */
+  void sort_indices( std::vector< size_t > & order ) const
+  {
+    std::sort( order.begin(), order.end(),
+               [ this ]( size_t lhs, size_t rhs )
+               {
+                 if( ( *xs )[ lhs ] != ( *xs )[ rhs ] )
+                   return ( *xs )[ lhs ] < ( *xs )[ rhs ];
+                 return ( *ys )[ lhs ] < ( *ys )[ rhs ];
+               } );
+  }
+
+  /**
+   * Compute the hull of the points in order with the chosen algorithm
+   * @param order the indices of the points, sorted on return
+   */
+  void local_hull( std::vector< size_t > & order )
+  {
+    sort_indices( order );
+    if( algorithm == Algorithm::QUICKHULL )
+    {
+      quickhull( order );
+    }
+    else
+    {
+      monotone_chain( order );
+    }
+  }
+
+  /**
+   * Compute local hulls on one chunk of points per thread, then the hull
+   * of their vertices, then mark the boundary points in parallel
+   * @param chpoints stores the points that are in the convex hull
+   */
+  void parallel_hull( std::vector< bool > & chpoints )
+  {
+    size_t n = xs->size();
+    // vector< bool > packs bits into words, so each chunk starts on a
+    // multiple of 64 points and no two threads ever write the same word
+    size_t chunk = ( ( n + threads - 1 ) / threads + 63 ) / 64 * 64;
+    std::vector< BasicConvexHull > workers( threads, *this );
+    std::vector< std::thread > pool;
+
+    for( unsigned t = 0; t < threads; t++ )
+    {
+      pool.emplace_back( [ &workers, t, chunk, n ]()
+                         {
+                           size_t begin = std::min( n, t * chunk );
+                           size_t end = std::min( n, begin + chunk );
+                           std::vector< size_t > order;
+                           for( size_t i = begin; i < end; i++ )
+                           {
+                             order.push_back( i );
+                           }
+                           if( !order.empty() )
+                             workers[ t ].local_hull( order );
+                         } );
+    }
+    std::vector< size_t > candidates;
+    for( unsigned t = 0; t < threads; t++ )
+    {
+      pool[ t ].join();
+      candidates.insert( candidates.end(), workers[ t ].hull.begin(),
+                         workers[ t ].hull.end() );
+      op_count += workers[ t ].op_count;
+    }
+    pool.clear();
+
+    // the hull of the local hull vertices is the hull of every point
+    sort_indices( candidates );
+    monotone_chain( candidates );
+
+    for( unsigned t = 0; t < threads; t++ )
+    {
+      workers[ t ].hull = hull;
+      workers[ t ].op_count = 0;
+      pool.emplace_back( [ &workers, &chpoints, t, chunk, n ]()
+                         {
+                           size_t begin = std::min( n, t * chunk );
+                           size_t end = std::min( n, begin + chunk );
+                           workers[ t ].mark_boundary( chpoints, begin, end );
+                         } );
+    }
+    for( unsigned t = 0; t < threads; t++ )
+    {
+      pool[ t ].join();
+      op_count += workers[ t ].op_count;
+    }
+  }
+
+  /**
+   * Andrew's monotone chain: build the lower hull left to right and the
+   * upper hull right to left over the sorted points, popping any point
+   * that does not make a strict left turn.
+   * @param order the indices of the points, sorted by x, then by y
+   */
+  void monotone_chain( const std::vector< size_t > & order )
+  {
+    size_t n = order.size();
+    if( n == 1 )
+    {
+      hull.push_back( order[ 0 ] );
+      return;
+    }
+
+    hull.resize( 2 * n );
+    size_t k = 0;
+    for( size_t i = 0; i < n; i++ )
+    {
+      while( k >= 2 && orient( hull[ k - 2 ], hull[ k - 1 ], order[ i ] ) <= 0 )
+        k--;
+      hull[ k++ ] = order[ i ];
+    }
+    for( size_t i = n - 1, lower = k + 1; i > 0; i-- )
+    {
+      while( k >= lower &&
+             orient( hull[ k - 2 ], hull[ k - 1 ], order[ i - 1 ] ) <= 0 )
+        k--;
+      hull[ k++ ] = order[ i - 1 ];
+    }
+    // the last point repeats the first
+    hull.resize( k - 1 );
+
+    // all input points coincide
+    if( hull.size() == 2 && ( *xs )[ hull[ 0 ] ] == ( *xs )[ hull[ 1 ] ]
+        && ( *ys )[ hull[ 0 ] ] == ( *ys )[ hull[ 1 ] ] )
+      hull.resize( 1 );
+  }
+
+  /**
+   * QuickHull: split the points by the line through the leftmost and
+   * rightmost points and recursively find the farthest point from each
+   * dividing line.
+   * @param order the indices of the points, sorted by x, then by y
+   */
+  void quickhull( const std::vector< size_t > & order )
+  {
+    size_t left = order.front();
+    size_t right = order.back();
+    hull.push_back( left );
+    if( ( *xs )[ left ] == ( *xs )[ right ] && ( *ys )[ left ] == ( *ys )[ right ] )
+      return;
+
+    std::vector< size_t > below;
+    std::vector< size_t > above;
+    for( size_t i = 1; i + 1 < order.size(); i++ )
+    {
+      int side = orient( left, right, order[ i ] );
+      if( side < 0 )
+        below.push_back( order[ i ] );
+      else if( side > 0 )
+        above.push_back( order[ i ] );
+    }
+
+    // counter-clockwise: lower chain from left to right, then upper back
+    quickhull_side( left, right, below );
+    hull.push_back( right );
+    quickhull_side( right, left, above );
+  }
+
+  /**
+   * Append, in order, the hull vertices strictly to the right of the
+   * directed line from a to b
+   * @param a the start of the dividing line
+   * @param b the end of the dividing line
+   * @param points the candidates, all strictly right of a to b
+   */
+  void quickhull_side( size_t a, size_t b, std::vector< size_t > & points )
+  {
+    if( points.empty() )
+      return;
+
+    size_t farthest = points[ 0 ];
+    decltype( area( a, b, farthest ) ) best = 0;
+    for( auto point : points )
+    {
+      auto distance = -area( a, b, point );
+      if( distance > best )
+      {
+        best = distance;
+        farthest = point;
+      }
+    }
+
+    std::vector< size_t > first_side;
+    std::vector< size_t > second_side;
+    for( auto point : points )
+    {
+      if( point == farthest )
+        continue;
+      if( orient( a, farthest, point ) < 0 )
+        first_side.push_back( point );
+      else if( orient( farthest, b, point ) < 0 )
+        second_side.push_back( point );
+    }
+    points.clear();
+    points.shrink_to_fit();
+
+    quickhull_side( a, farthest, first_side );
+    hull.push_back( farthest );
+    quickhull_side( farthest, b, second_side );
+  }
+
+  /**
+   * Mark every point that lies on the boundary of the hull. Each point
+   * is located in the fan of triangles around hull[ 0 ] by binary
+   * search, so this takes O(n log h).
+   * @param chpoints stores the points that are in the convex hull
+   * @param begin the first point to mark
+   * @param end one past the last point to mark
+   */
+  void mark_boundary( std::vector< bool > & chpoints, size_t begin,
+                      size_t end )
+  {
+    size_t h = hull.size();
+    for( size_t point = begin; point < end; point++ )
+    {
+      if( h <= 2 )
+      {
+        // a single point or a segment: every input point is on it
+        chpoints[ point ] = true;
+        continue;
+      }
+
+      // largest k in [1, h - 2] with point left of or on v0 -> vk
+      size_t low = 1;
+      size_t high = h - 2;
+      while( low < high )
+      {
+        size_t mid = ( low + high + 1 ) / 2;
+        if( orient( hull[ 0 ], hull[ mid ], point ) >= 0 )
+          low = mid;
+        else
+          high = mid - 1;
+      }
+
+      chpoints[ point ] =
+        orient( hull[ low ], hull[ low + 1 ], point ) == 0
+        || ( low == 1 && orient( hull[ 0 ], hull[ 1 ], point ) == 0 )
+        || ( low == h - 2 && orient( hull[ 0 ], hull[ h - 1 ], point ) == 0 );
+    }
+  }
+};
+
+/**
+ * The engine for the integer coordinates read by convex_hull.cpp
+ */
+typedef BasicConvexHull< int > ConvexHull;
+
+#endif
@@ -0,0 +1,178 @@
+/**
+ * stress benchmark for the ConvexHull engine on large coordinates
+ *
+ * generates random points whose coordinates sit near INT32_MAX (and,
+ * in a second run, span the whole int range), times every hull
+ * backend and checks each hull with the exact orientation predicate:
+ * consecutive vertices must turn counter-clockwise and no point may lie
+ * outside any hull edge. Integer hulls are checked by validate_hull from
+ * hull_kernels.h
+ *
+ * usage: convex_hull_bench [point count] [seed] [threads]
+ * the threads argument (default: all hardware threads) sets the
+ * thread count of the parallel runs
+ *
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "convex_hull.h"
+#include "hull_kernels.h"
+#include "orientation.h"
+
+using namespace std;
+
+/**
+ * Check that hull is a strictly convex counter-clockwise polygon that
+ * contains every point
+ * @param xcoords stores the x values in a vector
+ * @param ycoords stores the y values in a vector
+ * @param hull the hull vertex indices in counter-clockwise order
+ * @return true if the hull is valid
+ */
+template< typename Coord >
+bool check_hull( const vector< Coord > & xcoords,
+                 const vector< Coord > & ycoords,
+                 const vector< size_t > & hull );
+
+/**
+ * Run and time one backend on the points and print one result line
+ * @param label the name of the input distribution
+ * @param name the name of the backend
+ * @param algorithm the backend to run
+ * @param xcoords stores the x values in a vector
+ * @param ycoords stores the y values in a vector
+ * @param threads the number of threads the engine may use
+ * @return true if the hull is valid
+ */
+template< typename Coord >
+bool run( const string & label, const string & name,
+          typename BasicConvexHull< Coord >::Algorithm algorithm,
+          const vector< Coord > & xcoords, const vector< Coord > & ycoords,
+          unsigned threads = 1 );
+
+int main( int argc, char * argv[] )
+{
+  size_t n = argc > 1 ? strtoul( argv[ 1 ], nullptr, 10 ) : 1000000;
+  unsigned seed = argc > 2 ? strtoul( argv[ 2 ], nullptr, 10 ) : 320;
+  unsigned threads = argc > 3 ? strtoul( argv[ 3 ], nullptr, 10 )
+    : max( 1u, thread::hardware_concurrency() );
+  string parallel = "parallel/" + to_string( threads );
+  mt19937_64 generator( seed );
+
+  const int top = numeric_limits< int >::max();
+  uniform_int_distribution< int > near_max( top - ( 1 << 20 ), top );
+  uniform_int_distribution< int > full_range( numeric_limits< int >::min(),
+                                              top );
+
+  vector< int > xcoords( n );
+  vector< int > ycoords( n );
+  bool valid = true;
+
+  cout << left << setw( 12 ) << "input" << setw( 12 ) << "backend"
+       << setw( 10 ) << "hull" << setw( 14 ) << "basic ops"
+       << setw( 10 ) << "ms" << "valid" << endl;
+
+  for( size_t i = 0; i < n; i++ )
+  {
+    xcoords[ i ] = near_max( generator );
+    ycoords[ i ] = near_max( generator );
+  }
+  valid &= run< int >( "near max", "monotone",
+                       ConvexHull::Algorithm::MONOTONE_CHAIN,
+                       xcoords, ycoords );
+  valid &= run< int >( "near max", "quickhull",
+                       ConvexHull::Algorithm::QUICKHULL, xcoords, ycoords );
+
+  for( size_t i = 0; i < n; i++ )
+  {
+    xcoords[ i ] = full_range( generator );
+    ycoords[ i ] = full_range( generator );
+  }
+  valid &= run< int >( "full range", "monotone",
+                       ConvexHull::Algorithm::MONOTONE_CHAIN,
+                       xcoords, ycoords );
+  valid &= run< int >( "full range", "quickhull",
+                       ConvexHull::Algorithm::QUICKHULL, xcoords, ycoords );
+  valid &= run< int >( "full range", parallel,
+                       ConvexHull::Algorithm::MONOTONE_CHAIN,
+                       xcoords, ycoords, threads );
+
+  // the same points as doubles exercise the filtered predicate
+  vector< double > xdoubles( xcoords.begin(), xcoords.end() );
+  vector< double > ydoubles( ycoords.begin(), ycoords.end() );
+  valid &= run< double >( "double", "monotone",
+                          BasicConvexHull< double >::Algorithm::MONOTONE_CHAIN,
+                          xdoubles, ydoubles );
+
+  return valid ? 0 : 1;
+}
+
+template< typename Coord >
+bool check_hull( const vector< Coord > & xcoords,
+                 const vector< Coord > & ycoords,
+                 const vector< size_t > & hull )
+{
+  if constexpr( is_same< Coord, int >::value )
+    return validate_hull( xcoords, ycoords, hull );
+
+  size_t h = hull.size();
+  if( h < 3 )
+    return true;
+
+  for( size_t i = 0; i < h; i++ )
+  {
+    size_t a = hull[ i ];
+    size_t b = hull[ ( i + 1 ) % h ];
+    size_t c = hull[ ( i + 2 ) % h ];
+    if( orientation( xcoords[ a ], ycoords[ a ], xcoords[ b ], ycoords[ b ],
+                     xcoords[ c ], ycoords[ c ] ) <= 0 )
+      return false;
+  }
+  for( size_t point = 0; point < xcoords.size(); point++ )
+  {
+    for( size_t i = 0; i < h; i++ )
+    {
+      size_t a = hull[ i ];
+      size_t b = hull[ ( i + 1 ) % h ];
+      if( orientation( xcoords[ a ], ycoords[ a ], xcoords[ b ], ycoords[ b ],
+                       xcoords[ point ], ycoords[ point ] ) < 0 )
+        return false;
+    }
+  }
+  return true;
+}
+
+template< typename Coord >
+bool run( const string & label, const string & name,
+          typename BasicConvexHull< Coord >::Algorithm algorithm,
+          const vector< Coord > & xcoords, const vector< Coord > & ycoords,
+          unsigned threads )
+{
+  BasicConvexHull< Coord > engine( algorithm, threads );
+  vector< bool > chpoints( xcoords.size(), false );
+
+  auto start = chrono::steady_clock::now();
+  uint basic_ops = engine.compute( xcoords, ycoords, chpoints );
+  auto stop = chrono::steady_clock::now();
+
+  bool valid = check_hull( xcoords, ycoords, engine.get_hull() );
+  cout << left << setw( 12 ) << label << setw( 12 ) << name
+       << setw( 10 ) << engine.get_hull().size() << setw( 14 ) << basic_ops
+       << setw( 10 )
+       << chrono::duration< double, milli >( stop - start ).count()
+       << ( valid ? "yes" : "NO" ) << endl;
+  return valid;
+}
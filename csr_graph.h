@@ -0,0 +1,493 @@
+#ifndef MONEY_CSR_GRAPH
+#define MONEY_CSR_GRAPH
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "edge.h"
+#include "mapped_file.h"
+
+/**
+ * A weighted directed graph in compressed sparse row form: the edges
+ * out of vertex v are entries offsets[ v ] through offsets[ v + 1 ] - 1
+ * of two parallel arrays of targets and weights. An undirected graph
+ * stores every edge in both directions, as the text loaders in
+ * graph_io.h build it. Walking a vertex's edges reads contiguous
+ * memory instead of chasing one list node per edge.
+ *
+ * edges( v ) is a range whose iterator yields each edge as an Edge
+ * value, so code written against lists of Edge iterates a CSRGraph
+ * unchanged. The builders keep each vertex's edges in the
+ * order they were given.
+ *
+ * save writes a versioned binary file: a 32-byte header, then the
+ * offsets as 64-bit integers and the targets and weights as 32-bit
+ * ones, all in native byte order. load memory-maps such a file and
+ * reads the three arrays in place, so a graph of any size is ready
+ * once its offsets and targets have been checked, with nothing parsed
+ * or copied. Loading checks that the offsets never decrease and that
+ * every target is a vertex.
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+class CSRGraph
+{
+ public:
+  /**
+   * Iterates the edges out of one vertex, yielding Edge values; as its
+   * reference is a value, it is an input iterator, though it can be
+   * copied and walked again
+   */
+  class EdgeIterator
+  {
+   public:
+    /**
+     * Holds the Edge that operator-> points into
+     */
+    struct Arrow
+    {
+      Edge edge;
+      const Edge * operator->() const
+      {
+        return &edge;
+      }
+    };
+
+    typedef std::input_iterator_tag iterator_category;
+    typedef Edge value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Arrow pointer;
+    typedef Edge reference;
+
+    EdgeIterator( const CSRGraph * graph, uint vertex, size_t index )
+      : graph{ graph }, vertex{ vertex }, index{ index } {}
+
+    Edge operator*() const
+    {
+      Edge edge;
+      edge.start_vertex = vertex;
+      edge.end_vertex = graph->targets[ index ];
+      edge.weight = graph->weights[ index ];
+      return edge;
+    }
+
+    Arrow operator->() const
+    {
+      return Arrow{ **this };
+    }
+
+    EdgeIterator & operator++()
+    {
+      index++;
+      return *this;
+    }
+
+    EdgeIterator operator++( int )
+    {
+      EdgeIterator before = *this;
+      index++;
+      return before;
+    }
+
+    bool operator==( const EdgeIterator & other ) const
+    {
+      return index == other.index;
+    }
+
+    bool operator!=( const EdgeIterator & other ) const
+    {
+      return index != other.index;
+    }
+
+    /**
+     * Accessor for the position of the edge in the graph's arrays
+     * @return the edge index
+     */
+    size_t get_index() const
+    {
+      return index;
+    }
+
+   private:
+    const CSRGraph * graph;
+    uint vertex;
+    size_t index;
+  };
+
+  /**
+   * The edges out of one vertex, for range-based for loops
+   */
+  class EdgeRange
+  {
+   public:
+    EdgeRange( const CSRGraph * graph, uint vertex )
+      : graph{ graph }, vertex{ vertex } {}
+
+    EdgeIterator begin() const
+    {
+      return EdgeIterator( graph, vertex, graph->offsets[ vertex ] );
+    }
+
+    EdgeIterator end() const
+    {
+      return EdgeIterator( graph, vertex, graph->offsets[ vertex + 1 ] );
+    }
+
+    size_t size() const
+    {
+      return graph->offsets[ vertex + 1 ] - graph->offsets[ vertex ];
+    }
+
+    bool empty() const
+    {
+      return size() == 0;
+    }
+
+   private:
+    const CSRGraph * graph;
+    uint vertex;
+  };
+
+  /**
+   * Construct a graph with no vertices
+   */
+  CSRGraph() : owned_offsets( 1, 0 )
+  {
+    use_owned();
+  }
+
+  CSRGraph( const CSRGraph & ) = delete;
+  CSRGraph & operator=( const CSRGraph & ) = delete;
+  CSRGraph( CSRGraph && ) = default;
+  CSRGraph & operator=( CSRGraph && ) = default;
+
+  /**
+   * Build from a list of directed edges with a stable counting sort
+   * @param vertices the number of vertices
+   * @param edges the edges; each is stored once, from its start vertex
+   */
+  CSRGraph( size_t vertices, const std::vector< Edge > & edges )
+    : owned_offsets( vertices + 1, 0 ), owned_targets( edges.size() ),
+      owned_weights( edges.size() )
+  {
+    for( auto & edge : edges )
+    {
+      owned_offsets[ edge.start_vertex + 1 ]++;
+    }
+    for( size_t v = 0; v < vertices; v++ )
+    {
+      owned_offsets[ v + 1 ] += owned_offsets[ v ];
+    }
+    std::vector< size_t > next( owned_offsets.begin(),
+                                owned_offsets.end() - 1 );
+    for( auto & edge : edges )
+    {
+      size_t index = next[ edge.start_vertex ]++;
+      owned_targets[ index ] = edge.end_vertex;
+      owned_weights[ index ] = edge.weight;
+    }
+    use_owned();
+  }
+
+  /**
+   * Build an undirected graph from lists of edges, each given once and
+   * stored in both directions, in the order of the lists and then of
+   * the edges in each. One thread per list sorts its edges, in both
+   * directions, into a bucket per range of vertices and releases the
+   * list; one thread per range then counts its vertices' edges out of
+   * its buckets and, after a prefix sum over all the counts, places
+   * them. Every edge is read a fixed number of times whatever the
+   * thread count, and every vertex's edges keep the given order.
+   * @param vertices the number of vertices
+   * @param parts the edges, emptied by the build
+   * @param threads the number of ranges of vertices to build with
+   */
+  CSRGraph( size_t vertices, std::vector< std::vector< Edge > > & parts,
+            unsigned threads = 1 )
+    : owned_offsets( vertices + 1, 0 )
+  {
+    size_t ranges = threads > 0 ? threads : 1;
+    // range r holds vertices vertices * r / ranges and up; this is the
+    // last range starting at or below the vertex
+    auto range_of = [ & ]( uint vertex )
+      {
+        return ( ( vertex + size_t( 1 ) ) * ranges - 1 ) / vertices;
+      };
+    auto in_parallel = [ & ]( size_t count, auto body )
+      {
+        std::vector< std::thread > pool;
+        for( size_t i = 1; i < count; i++ )
+        {
+          pool.emplace_back( body, i );
+        }
+        if( count > 0 )
+          body( 0 );
+        for( auto & worker : pool )
+        {
+          worker.join();
+        }
+      };
+
+    // buckets[ p ][ r ] holds part p's edges out of range r, directed
+    std::vector< std::vector< std::vector< Edge > > > buckets(
+      parts.size(), std::vector< std::vector< Edge > >( ranges ) );
+    in_parallel( parts.size(), [ & ]( size_t p )
+                 {
+                   for( auto & bucket : buckets[ p ] )
+                   {
+                     bucket.reserve( 2 * parts[ p ].size() / ranges );
+                   }
+                   for( auto & edge : parts[ p ] )
+                   {
+                     Edge reverse = edge;
+                     reverse.start_vertex = edge.end_vertex;
+                     reverse.end_vertex = edge.start_vertex;
+                     buckets[ p ][ range_of( edge.start_vertex ) ]
+                       .push_back( edge );
+                     buckets[ p ][ range_of( reverse.start_vertex ) ]
+                       .push_back( reverse );
+                   }
+                   std::vector< Edge >().swap( parts[ p ] );
+                 } );
+
+    in_parallel( ranges, [ & ]( size_t r )
+                 {
+                   for( auto & part : buckets )
+                   {
+                     for( auto & edge : part[ r ] )
+                     {
+                       owned_offsets[ edge.start_vertex + 1 ]++;
+                     }
+                   }
+                 } );
+    for( size_t v = 0; v < vertices; v++ )
+    {
+      owned_offsets[ v + 1 ] += owned_offsets[ v ];
+    }
+    owned_targets.resize( owned_offsets.back() );
+    owned_weights.resize( owned_offsets.back() );
+    std::vector< size_t > next( owned_offsets.begin(),
+                                owned_offsets.end() - 1 );
+    in_parallel( ranges, [ & ]( size_t r )
+                 {
+                   for( auto & part : buckets )
+                   {
+                     for( auto & edge : part[ r ] )
+                     {
+                       size_t index = next[ edge.start_vertex ]++;
+                       owned_targets[ index ] = edge.end_vertex;
+                       owned_weights[ index ] = edge.weight;
+                     }
+                     std::vector< Edge >().swap( part[ r ] );
+                   }
+                 } );
+    use_owned();
+  }
+
+  /**
+   * Write the graph to a file that load can map
+   * @param path the file to write
+   * @return true if written
+   */
+  bool save( const std::string & path ) const
+  {
+    FILE * file = fopen( path.c_str(), "wb" );
+    if( file == nullptr )
+      return false;
+    Header header{ {}, VERSION, 0, vertex_count, edge_total };
+    memcpy( header.magic, MAGIC, sizeof( header.magic ) );
+    bool written = fwrite( &header, sizeof( header ), 1, file ) == 1 &&
+      fwrite( offsets, sizeof( uint64_t ), vertex_count + 1, file )
+        == vertex_count + 1 &&
+      fwrite( targets, sizeof( uint ), edge_total, file ) == edge_total &&
+      fwrite( weights, sizeof( uint ), edge_total, file ) == edge_total;
+    return fclose( file ) == 0 && written;
+  }
+
+  /**
+   * Map a file written by save and use its arrays in place
+   * @param path the file to map
+   * @return true if the file holds a well-formed graph of this version;
+   *         if not, the graph is left as it was
+   */
+  bool load( const std::string & path )
+  {
+    std::unique_ptr< MappedFile > file( new MappedFile( path ) );
+    if( !file->is_open() || file->size() < sizeof( Header ) )
+      return false;
+    Header header;
+    memcpy( &header, file->data(), sizeof( header ) );
+    if( memcmp( header.magic, MAGIC, sizeof( header.magic ) ) != 0 ||
+        header.version != VERSION || header.vertices >= UINT32_MAX )
+      return false;
+
+    // sizes from the header are checked against the file by division,
+    // so no product of them can overflow
+    size_t body = file->size() - sizeof( Header );
+    if( header.vertices + 1 > body / sizeof( uint64_t ) )
+      return false;
+    size_t arrays = body - ( header.vertices + 1 ) * sizeof( uint64_t );
+    if( header.edges > arrays / ( 2 * sizeof( uint ) )
+        || arrays != header.edges * 2 * sizeof( uint ) )
+      return false;
+
+    const size_t * mapped_offsets = reinterpret_cast< const size_t * >(
+      file->data() + sizeof( Header ) );
+    const uint * mapped_targets = reinterpret_cast< const uint * >(
+      mapped_offsets + header.vertices + 1 );
+    if( mapped_offsets[ 0 ] != 0
+        || mapped_offsets[ header.vertices ] != header.edges )
+      return false;
+    for( size_t v = 0; v < header.vertices; v++ )
+    {
+      if( mapped_offsets[ v + 1 ] < mapped_offsets[ v ] )
+        return false;
+    }
+    for( size_t e = 0; e < header.edges; e++ )
+    {
+      if( mapped_targets[ e ] >= header.vertices )
+        return false;
+    }
+
+    mapping = std::move( file );
+    owned_offsets = std::vector< size_t >();
+    owned_targets = std::vector< uint >();
+    owned_weights = std::vector< uint >();
+    vertex_count = header.vertices;
+    edge_total = header.edges;
+    offsets = mapped_offsets;
+    targets = mapped_targets;
+    weights = mapped_targets + edge_total;
+    return true;
+  }
+
+  /**
+   * Report whether a file starts like one save writes
+   * @param path the file to check
+   * @return true if it has the header of this version
+   */
+  static bool is_binary( const std::string & path )
+  {
+    MappedFile file( path );
+    Header header;
+    if( !file.is_open() || file.size() < sizeof( Header ) )
+      return false;
+    memcpy( &header, file.data(), sizeof( header ) );
+    return memcmp( header.magic, MAGIC, sizeof( header.magic ) ) == 0;
+  }
+
+  /**
+   * Accessor for the number of vertices
+   * @return the vertex count
+   */
+  size_t size() const
+  {
+    return vertex_count;
+  }
+
+  /**
+   * Accessor for the number of stored edges; an undirected edge
+   * counts twice
+   * @return the edge count
+   */
+  size_t edge_count() const
+  {
+    return edge_total;
+  }
+
+  /**
+   * The edges out of a vertex
+   * @param vertex the vertex
+   * @return a range of Edge values
+   */
+  EdgeRange edges( uint vertex ) const
+  {
+    return EdgeRange( this, vertex );
+  }
+
+  /**
+   * Accessor for the number of edges out of a vertex
+   * @param vertex the vertex
+   * @return its out-degree
+   */
+  size_t degree( uint vertex ) const
+  {
+    return offsets[ vertex + 1 ] - offsets[ vertex ];
+  }
+
+  /**
+   * Accessor for the index of a vertex's first edge; its edges are
+   * begin( v ) through begin( v + 1 ) - 1
+   * @param vertex the vertex, or size() for the end of the arrays
+   * @return the edge index
+   */
+  size_t begin( uint vertex ) const
+  {
+    return offsets[ vertex ];
+  }
+
+  /**
+   * Accessor for the vertex an edge leads to
+   * @param index the edge index
+   * @return the target vertex
+   */
+  uint target( size_t index ) const
+  {
+    return targets[ index ];
+  }
+
+  /**
+   * Accessor for the weight of an edge
+   * @param index the edge index
+   * @return the weight
+   */
+  uint weight( size_t index ) const
+  {
+    return weights[ index ];
+  }
+
+ private:
+  static constexpr char MAGIC[ 8 ] = { 'M', 'O', 'N', 'E', 'Y', 'C', 'S', 'R' };
+  static constexpr uint32_t VERSION = 1;
+  static_assert( sizeof( size_t ) == sizeof( uint64_t ),
+                 "the file stores offsets as 64-bit integers" );
+
+  struct Header
+  {
+    char magic[ 8 ];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t vertices;
+    uint64_t edges;
+  };
+
+  const size_t * offsets; // into owned_offsets or mapping
+  const uint * targets;
+  const uint * weights;
+  size_t vertex_count;
+  size_t edge_total;
+  std::vector< size_t > owned_offsets;
+  std::vector< uint > owned_targets;
+  std::vector< uint > owned_weights;
+  std::unique_ptr< MappedFile > mapping;
+
+  /**
+   * Point the arrays at the owned vectors
+   */
+  void use_owned()
+  {
+    offsets = owned_offsets.data();
+    targets = owned_targets.data();
+    weights = owned_weights.data();
+    vertex_count = owned_offsets.size() - 1;
+    edge_total = owned_targets.size();
+  }
+};
+
+#endif
@@ -0,0 +1,30 @@
+#ifndef MONEY_EDGE
+#define MONEY_EDGE
+
+#include <sys/types.h>
+
+/**
+ * A weighted directed edge, the unit the graph code passes around: an
+ * undirected graph holds each of its edges once in each direction.
+ * Edges order by weight alone.
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+struct Edge
+{
+  uint start_vertex;
+  uint end_vertex;
+  uint weight;
+
+  /**
+   * Order edges by weight
+   * @param rhs the edge to compare with
+   * @return true if this edge is lighter
+   */
+  bool operator<( const Edge & rhs ) const
+  {
+    return weight < rhs.weight;
+  }
+};
+
+#endif
@@ -0,0 +1,144 @@
+#ifndef MONEY_EDGE_WEIGHTS
+#define MONEY_EDGE_WEIGHTS
+
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "csr_graph.h"
+#include "hash_map.h"
+
+/**
+ * Constant-time weight lookup for any pair of vertices of an undirected
+ * CSRGraph, for tour code that steps between vertices the walk did not
+ * reach along an edge. A graph with at least half of all possible
+ * edges gets a V by V matrix, which then takes no more memory than the
+ * graph's own arrays; a sparser graph gets a HashMap keyed by the pair,
+ * smaller end first. Of repeated edges between one pair the lightest
+ * is kept.
+ *
+ * A set of points stands for the complete graph on them with Euclidean
+ * distances as weights, each computed when asked for and rounded to
+ * the nearest integer, so the lookup itself takes no memory beyond the
+ * caller's coordinates, which must outlive it.
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+class EdgeWeights
+{
+ public:
+  static constexpr uint ABSENT = UINT_MAX;
+
+  /**
+   * Build the lookup for a graph
+   * @param graph the graph, every edge in both directions, weights
+   *        below ABSENT
+   */
+  explicit EdgeWeights( const CSRGraph & graph )
+    : vertices{ graph.size() },
+      dense{ graph.edge_count() * 2 >= graph.size() * graph.size() },
+      sparse( dense ? 0 : graph.edge_count() / 2 ), xs{ nullptr },
+      ys{ nullptr }
+  {
+    if( dense )
+      matrix.assign( vertices * vertices, ABSENT );
+    for( size_t v = 0; v < vertices; v++ )
+    {
+      for( size_t e = graph.begin( v ); e < graph.begin( v + 1 ); e++ )
+      {
+        uint to = graph.target( e );
+        if( dense )
+        {
+          uint & entry = matrix[ v * vertices + to ];
+          if( graph.weight( e ) < entry )
+            entry = graph.weight( e );
+        }
+        else if( v < to )
+        {
+          uint64_t key = pair_key( v, to );
+          uint * entry = sparse.find( key );
+          if( entry == nullptr )
+            sparse.insert( key, graph.weight( e ) );
+          else if( graph.weight( e ) < *entry )
+            *entry = graph.weight( e );
+        }
+      }
+    }
+  }
+
+  /**
+   * Build the lookup for the complete Euclidean graph on a set of points
+   * @param xcoords the x coordinates, one per vertex
+   * @param ycoords the y coordinates, one per vertex
+   */
+  EdgeWeights( const std::vector< int > & xcoords,
+               const std::vector< int > & ycoords )
+    : vertices{ xcoords.size() }, dense{ false }, sparse( 0 ),
+      xs{ xcoords.data() }, ys{ ycoords.data() } {}
+
+  /**
+   * Round a distance given as its square to a weight, the nearest
+   * integer, capped below ABSENT
+   * @param squared the squared distance
+   * @return the weight
+   */
+  static uint round_distance( double squared )
+  {
+    double distance = std::sqrt( squared ) + 0.5;
+    return distance < double( ABSENT ) ? uint( distance ) : ABSENT - 1;
+  }
+
+  /**
+   * Look up the weight of the edge between two vertices
+   * @param from a vertex
+   * @param to a vertex
+   * @return the weight, or ABSENT if they are not joined
+   */
+  uint get( uint from, uint to )
+  {
+    if( xs != nullptr )
+    {
+      double dx = double( xs[ from ] ) - xs[ to ];
+      double dy = double( ys[ from ] ) - ys[ to ];
+      return round_distance( dx * dx + dy * dy );
+    }
+    if( dense )
+      return matrix[ size_t( from ) * vertices + to ];
+    uint * entry = sparse.find( from < to ? pair_key( from, to )
+                                : pair_key( to, from ) );
+    return entry == nullptr ? ABSENT : *entry;
+  }
+
+  /**
+   * Accessor for which representation was chosen
+   * @return true for the matrix, false for the hash map or points
+   */
+  bool is_dense() const
+  {
+    return dense;
+  }
+
+ private:
+  /**
+   * The key itself; HashMap mixes its bits before use
+   */
+  static size_t hash_key( const uint64_t & key, size_t )
+  {
+    return size_t( key );
+  }
+
+  static uint64_t pair_key( uint low, uint high )
+  {
+    return uint64_t( low ) << 32 | high;
+  }
+
+  size_t vertices;
+  bool dense;
+  std::vector< uint > matrix;
+  HashMap< uint64_t, uint, hash_key > sparse;
+  const int * xs; // the points, if the graph is Euclidean
+  const int * ys;
+};
+
+#endif
@@ -0,0 +1,335 @@
+#ifndef MONEY_EUCLIDEAN_MST
+#define MONEY_EUCLIDEAN_MST
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "csr_graph.h"
+#include "edge.h"
+#include "edge_weights.h"
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+#define MONEY_EUCLIDEAN_X86 1
+#include <immintrin.h>
+#endif
+
+/**
+ * Minimum spanning tree of the complete graph on a set of points, with
+ * the Euclidean distance as the weight, for hamiltonian_MST.cpp's
+ * --points mode. No edge is ever stored: this is the O(V^2) array
+ * form of Prim's algorithm, which is optimal for a complete graph.
+ * Every vertex outside the tree keeps its squared distance to the tree
+ * and the tree vertex it is measured from; each step relaxes them all
+ * against the vertex just added, picks the nearest, and swaps it out
+ * of the arrays, so the loop always runs over a contiguous prefix.
+ * Memory is a few arrays of V entries.
+ *
+ * The relax-and-pick loop is a data-parallel kernel. Coordinates are
+ * converted to double, where the squared distance between int points
+ * is exact up to differences of 2^26, so the kernels compare exactly
+ * and return exactly what the scalar loop does; the widest kernel the
+ * running CPU supports (AVX2, SSE2 or portable scalar) is picked on
+ * first use. Weights are distances rounded to the nearest integer, as
+ * EdgeWeights::round_distance does.
+ *
+ * The tree comes out as a CSRGraph with each edge in both directions
+ * in the order vertices joined it, as MST's does, so TwiceAround walks
+ * it unchanged. A basic operation is one distance computed.
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+
+namespace euclidean_kernels
+{
+  /**
+   * One relax-and-pick step: lower key[ i ] to the squared distance
+   * from ( x, y ) to point i and set parent[ i ] to from where that is
+   * smaller, for i below n
+   * @return the first index of the smallest key after the update
+   */
+  typedef size_t ( *Kernel )( double, double, const double *,
+                              const double *, double *, double *, double,
+                              size_t );
+
+  /**
+   * The portable kernel, also used for the tail of the vector kernels
+   */
+  inline size_t relax_scalar( double x, double y, const double * xs,
+                              const double * ys, double * key,
+                              double * parent, double from, size_t n )
+  {
+    size_t best = 0;
+    for( size_t i = 0; i < n; i++ )
+    {
+      double dx = xs[ i ] - x;
+      double dy = ys[ i ] - y;
+      double distance = dx * dx + dy * dy;
+      if( distance < key[ i ] )
+      {
+        key[ i ] = distance;
+        parent[ i ] = from;
+      }
+      if( key[ i ] < key[ best ] )
+        best = i;
+    }
+    return best;
+  }
+
+  /**
+   * Combine the lanes of a vector kernel and run the scalar kernel on
+   * the points from done on; of equal keys the lowest index wins, as in
+   * the scalar loop
+   */
+  inline size_t finish( const double * keys, const double * indices,
+                        int lanes, size_t done, double x, double y,
+                        const double * xs, const double * ys, double * key,
+                        double * parent, double from, size_t n )
+  {
+    size_t best = n;
+    double best_key = __builtin_inf();
+    for( int lane = 0; lane < lanes; lane++ )
+    {
+      size_t candidate = size_t( indices[ lane ] );
+      if( candidate < done && ( keys[ lane ] < best_key
+          || ( keys[ lane ] == best_key && candidate < best ) ) )
+      {
+        best_key = keys[ lane ];
+        best = candidate;
+      }
+    }
+    if( done < n )
+    {
+      size_t tail = done + relax_scalar( x, y, xs + done, ys + done,
+                                         key + done, parent + done, from,
+                                         n - done );
+      if( best == n || key[ tail ] < best_key )
+        best = tail;
+    }
+    return best == n ? 0 : best;
+  }
+
+#ifdef MONEY_EUCLIDEAN_X86
+  /**
+   * The SSE2 kernel, two points per step
+   */
+  __attribute__(( target( "sse2" ) ))
+  inline size_t relax_sse2( double x, double y, const double * xs,
+                            const double * ys, double * key, double * parent,
+                            double from, size_t n )
+  {
+    const __m128d px = _mm_set1_pd( x ), py = _mm_set1_pd( y );
+    const __m128d source = _mm_set1_pd( from );
+    const __m128d step = _mm_set1_pd( 2.0 );
+    __m128d index = _mm_set_pd( 1.0, 0.0 );
+    __m128d best_key = _mm_set1_pd( __builtin_inf() );
+    __m128d best_index = _mm_setzero_pd();
+
+    size_t i = 0;
+    for( ; i + 2 <= n; i += 2 )
+    {
+      __m128d dx = _mm_sub_pd( _mm_loadu_pd( xs + i ), px );
+      __m128d dy = _mm_sub_pd( _mm_loadu_pd( ys + i ), py );
+      __m128d distance = _mm_add_pd( _mm_mul_pd( dx, dx ),
+                                     _mm_mul_pd( dy, dy ) );
+      __m128d old_key = _mm_loadu_pd( key + i );
+      __m128d closer = _mm_cmplt_pd( distance, old_key );
+      __m128d new_key = _mm_or_pd( _mm_and_pd( closer, distance ),
+                                   _mm_andnot_pd( closer, old_key ) );
+      __m128d new_parent = _mm_or_pd(
+        _mm_and_pd( closer, source ),
+        _mm_andnot_pd( closer, _mm_loadu_pd( parent + i ) ) );
+      _mm_storeu_pd( key + i, new_key );
+      _mm_storeu_pd( parent + i, new_parent );
+
+      __m128d better = _mm_cmplt_pd( new_key, best_key );
+      best_key = _mm_or_pd( _mm_and_pd( better, new_key ),
+                            _mm_andnot_pd( better, best_key ) );
+      best_index = _mm_or_pd( _mm_and_pd( better, index ),
+                              _mm_andnot_pd( better, best_index ) );
+      index = _mm_add_pd( index, step );
+    }
+
+    double keys[ 2 ];
+    double indices[ 2 ];
+    _mm_storeu_pd( keys, best_key );
+    _mm_storeu_pd( indices, best_index );
+    return finish( keys, indices, 2, i, x, y, xs, ys, key, parent, from, n );
+  }
+
+  /**
+   * The AVX2 kernel, four points per step
+   */
+  __attribute__(( target( "avx2" ) ))
+  inline size_t relax_avx2( double x, double y, const double * xs,
+                            const double * ys, double * key, double * parent,
+                            double from, size_t n )
+  {
+    const __m256d px = _mm256_set1_pd( x ), py = _mm256_set1_pd( y );
+    const __m256d source = _mm256_set1_pd( from );
+    const __m256d step = _mm256_set1_pd( 4.0 );
+    __m256d index = _mm256_set_pd( 3.0, 2.0, 1.0, 0.0 );
+    __m256d best_key = _mm256_set1_pd( __builtin_inf() );
+    __m256d best_index = _mm256_setzero_pd();
+
+    size_t i = 0;
+    for( ; i + 4 <= n; i += 4 )
+    {
+      __m256d dx = _mm256_sub_pd( _mm256_loadu_pd( xs + i ), px );
+      __m256d dy = _mm256_sub_pd( _mm256_loadu_pd( ys + i ), py );
+      __m256d distance = _mm256_add_pd( _mm256_mul_pd( dx, dx ),
+                                        _mm256_mul_pd( dy, dy ) );
+      __m256d old_key = _mm256_loadu_pd( key + i );
+      __m256d closer = _mm256_cmp_pd( distance, old_key, _CMP_LT_OQ );
+      __m256d new_key = _mm256_blendv_pd( old_key, distance, closer );
+      __m256d new_parent = _mm256_blendv_pd( _mm256_loadu_pd( parent + i ),
+                                             source, closer );
+      _mm256_storeu_pd( key + i, new_key );
+      _mm256_storeu_pd( parent + i, new_parent );
+
+      __m256d better = _mm256_cmp_pd( new_key, best_key, _CMP_LT_OQ );
+      best_key = _mm256_blendv_pd( best_key, new_key, better );
+      best_index = _mm256_blendv_pd( best_index, index, better );
+      index = _mm256_add_pd( index, step );
+    }
+
+    double keys[ 4 ];
+    double indices[ 4 ];
+    _mm256_storeu_pd( keys, best_key );
+    _mm256_storeu_pd( indices, best_index );
+    return finish( keys, indices, 4, i, x, y, xs, ys, key, parent, from, n );
+  }
+#endif
+
+  /**
+   * Pick the widest kernel the running CPU supports
+   */
+  inline Kernel select_kernel()
+  {
+#ifdef MONEY_EUCLIDEAN_X86
+    __builtin_cpu_init();
+    if( __builtin_cpu_supports( "avx2" ) )
+      return relax_avx2;
+    if( __builtin_cpu_supports( "sse2" ) )
+      return relax_sse2;
+#endif
+    return relax_scalar;
+  }
+
+  /**
+   * The kernel chosen for this process, resolved once
+   */
+  inline Kernel & active_kernel()
+  {
+    static Kernel kernel = select_kernel();
+    return kernel;
+  }
+}
+
+class EuclideanMST
+{
+ public:
+  /**
+   * Construct an engine
+   */
+  EuclideanMST() : weight{ 0 }, op_count{ 0 } {}
+
+  /**
+   * Compute the minimum spanning tree of the complete graph on a set
+   * of points
+   * @param xcoords the x coordinates
+   * @param ycoords the y coordinates
+   * @param mst set to the tree, every edge in both directions
+   * @return the number of basic operations
+   */
+  size_t compute( const std::vector< int > & xcoords,
+                  const std::vector< int > & ycoords, CSRGraph & mst )
+  {
+    size_t n = xcoords.size();
+    weight = 0;
+    op_count = 0;
+
+    // the vertices outside the tree, kept in the first remaining slots
+    std::vector< double > xs( xcoords.begin(), xcoords.end() );
+    std::vector< double > ys( ycoords.begin(), ycoords.end() );
+    std::vector< double > key( n, __builtin_inf() );
+    std::vector< double > parent( n, 0 );
+    std::vector< uint > id( n );
+    for( size_t i = 0; i < n; i++ )
+    {
+      id[ i ] = i;
+    }
+
+    std::vector< Edge > tree_edges;
+    tree_edges.reserve( n > 0 ? 2 * ( n - 1 ) : 0 );
+    size_t remaining = n;
+    size_t added = 0; // vertex 0 joins first
+    while( remaining > 0 )
+    {
+      uint vertex = id[ added ];
+      double x = xs[ added ];
+      double y = ys[ added ];
+      remaining--;
+      swap_out( added, remaining, xs, ys, key, parent, id );
+      if( remaining == 0 )
+        break;
+
+      op_count += remaining;
+      added = euclidean_kernels::active_kernel()( x, y, xs.data(),
+                                                   ys.data(), key.data(),
+                                                   parent.data(), vertex,
+                                                   remaining );
+      Edge edge;
+      edge.start_vertex = uint( parent[ added ] );
+      edge.end_vertex = id[ added ];
+      edge.weight = EdgeWeights::round_distance( key[ added ] );
+      tree_edges.push_back( edge );
+      std::swap( edge.start_vertex, edge.end_vertex );
+      tree_edges.push_back( edge );
+      weight += edge.weight;
+    }
+    mst = CSRGraph( n, tree_edges );
+    return op_count;
+  }
+
+  /**
+   * Accessor for the weight of the last tree computed
+   * @return the sum of the rounded tree edge weights
+   */
+  uint64_t get_weight() const
+  {
+    return weight;
+  }
+
+  /**
+   * Accessor for the basic operations of the last computation
+   * @return the count of basic operations
+   */
+  size_t get_op_count() const
+  {
+    return op_count;
+  }
+
+ private:
+  uint64_t weight;
+  size_t op_count;
+
+  /**
+   * Move the entry at index to last, the first slot past the ones
+   * still outside the tree
+   */
+  static void swap_out( size_t index, size_t last, std::vector< double > & xs,
+                        std::vector< double > & ys,
+                        std::vector< double > & key,
+                        std::vector< double > & parent,
+                        std::vector< uint > & id )
+  {
+    std::swap( xs[ index ], xs[ last ] );
+    std::swap( ys[ index ], ys[ last ] );
+    std::swap( key[ index ], key[ last ] );
+    std::swap( parent[ index ], parent[ last ] );
+    std::swap( id[ index ], id[ last ] );
+  }
+};
+
+#endif
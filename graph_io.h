@@ -0,0 +1,206 @@
+#ifndef MONEY_GRAPH_IO
+#define MONEY_GRAPH_IO
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "csr_graph.h"
+#include "edge.h"
+#include "mapped_file.h"
+#include "point_io.h"
+
+/**
+ * Graph loading for hamiltonian_MST.cpp straight into a CSRGraph, with
+ * no adjacency lists and no separate list of all edges kept alongside.
+ *
+ * A text graph is the vertex count, then one "from to weight" line per
+ * undirected edge. A file is memory-mapped and a stream is read whole
+ * into a buffer; either way the text is split at line boundaries into
+ * one part per thread, each thread scans its part with the point_io
+ * integer scanner into its own list of edges, and the threads then
+ * bucket the edges by range of vertices and place each range into CSR
+ * form, in input order. The lists are released once bucketed, and a
+ * graph piped to stdin and the same graph in a file come out edge for
+ * edge the same.
+ *
+ * A binary graph is a file written by CSRGraph::save and is mapped in
+ * place by CSRGraph::load; load_graph tells the two apart by the
+ * binary header.
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+
+namespace graph_io_detail
+{
+  /**
+   * The offset of the first line that starts at or after offset
+   */
+  inline size_t line_start( const char * text, size_t length, size_t offset )
+  {
+    if( offset == 0 || offset >= length )
+      return std::min( offset, length );
+    const void * newline = memchr( text + offset - 1, '\n',
+                                   length - offset + 1 );
+    return newline == nullptr ? length
+      : static_cast< const char * >( newline ) - text + 1;
+  }
+
+  /**
+   * Scan whole "from to weight" triples out of [begin, end) into edges
+   * @return false on malformed input or a vertex not below vertices
+   */
+  inline bool scan_edges( const char * begin, const char * end,
+                          size_t vertices, std::vector< Edge > & edges )
+  {
+    using point_io_detail::Scan;
+    using point_io_detail::is_space;
+
+    const char * position = begin;
+    while( true )
+    {
+      uint values[ 3 ];
+      for( int i = 0; i < 3; i++ )
+      {
+        while( position != end && is_space( *position ) )
+          position++;
+        if( position == end )
+          return i == 0;
+        if( point_io_detail::scan_integer( position, end, true,
+                                           values[ i ] ) != Scan::OK )
+          return false;
+      }
+      if( values[ 0 ] >= vertices || values[ 1 ] >= vertices )
+        return false;
+      Edge edge;
+      edge.start_vertex = values[ 0 ];
+      edge.end_vertex = values[ 1 ];
+      edge.weight = values[ 2 ];
+      edges.push_back( edge );
+    }
+  }
+
+  /**
+   * Parse a text graph held in memory into a CSRGraph on several threads
+   * @return false on malformed input, leaving the graph as it was
+   */
+  inline bool parse_text_graph( const char * text, size_t length,
+                                CSRGraph & graph, unsigned threads )
+  {
+    using point_io_detail::is_space;
+
+    // the vertex count comes first, on a line of its own
+    const char * end = text + length;
+    const char * position = text;
+    while( position != end && is_space( *position ) )
+      position++;
+    uint vertices;
+    if( point_io_detail::scan_integer( position, end, true, vertices )
+        != point_io_detail::Scan::OK )
+      return false;
+    size_t body = position - text;
+
+    threads = std::max( 1u, threads );
+    std::vector< size_t > bounds{ body };
+    for( unsigned part = 1; part < threads; part++ )
+    {
+      size_t part_length = length - body;
+      bounds.push_back( std::max( bounds.back(), line_start(
+        text, length, body + part_length / threads * part ) ) );
+    }
+    bounds.push_back( length );
+
+    std::vector< std::vector< Edge > > parts( threads );
+    std::vector< char > ok( threads, true );
+    auto parse = [ & ]( unsigned part )
+      {
+        parts[ part ].reserve( ( bounds[ part + 1 ] - bounds[ part ] ) / 12 );
+        ok[ part ] = scan_edges( text + bounds[ part ],
+                                 text + bounds[ part + 1 ], vertices,
+                                 parts[ part ] );
+      };
+    std::vector< std::thread > pool;
+    for( unsigned part = 1; part < threads; part++ )
+    {
+      pool.emplace_back( parse, part );
+    }
+    parse( 0 );
+    for( auto & worker : pool )
+    {
+      worker.join();
+    }
+    if( std::find( ok.begin(), ok.end(), false ) != ok.end() )
+      return false;
+
+    graph = CSRGraph( vertices, parts, threads );
+    return true;
+  }
+}
+
+/**
+ * Parse a text graph file into a CSRGraph on several threads
+ * @param path the file to load
+ * @param graph set to the graph, every edge in both directions
+ * @param threads the number of threads to parse with
+ * @return true if the file was read and well formed; if not, the graph
+ *         is left as it was
+ */
+inline bool load_text_graph( const std::string & path, CSRGraph & graph,
+                             unsigned threads = 1 )
+{
+  MappedFile file( path );
+  if( !file.is_open() )
+    return false;
+  return graph_io_detail::parse_text_graph( file.data(), file.size(), graph,
+                                            threads );
+}
+
+/**
+ * Read a text graph from a stream, such as stdin, into a CSRGraph on
+ * several threads
+ * @param stream the stream to read to its end
+ * @param graph set to the graph, every edge in both directions
+ * @param threads the number of threads to parse with
+ * @return true if the stream was read and well formed; if not, the
+ *         graph is left as it was
+ */
+inline bool read_text_graph( FILE * stream, CSRGraph & graph,
+                             unsigned threads = 1 )
+{
+  const size_t chunk = 1 << 20;
+  std::vector< char > text;
+  size_t length = 0;
+  while( true )
+  {
+    text.resize( length + chunk );
+    size_t got = fread( text.data() + length, 1, chunk, stream );
+    length += got;
+    if( got == 0 )
+      break;
+  }
+  if( ferror( stream ) )
+    return false;
+  return graph_io_detail::parse_text_graph( text.data(), length, graph,
+                                            threads );
+}
+
+/**
+ * Load a graph file, binary or text
+ * @param path the file to load
+ * @param graph set to the graph, every edge in both directions
+ * @param threads the number of threads to parse text with
+ * @return true if the file was read and well formed
+ */
+inline bool load_graph( const std::string & path, CSRGraph & graph,
+                        unsigned threads = 1 )
+{
+  if( CSRGraph::is_binary( path ) )
+    return graph.load( path );
+  return load_text_graph( path, graph, threads );
+}
+
+#endif
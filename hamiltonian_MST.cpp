@@ -2,189 +2,292 @@
    *Finds the MST @author Jon Beck
    *Computes the twice around algorithm to find
    *a hamiltonian circuit using MST
+   *
+   *usage: hamiltonian_MST [prim | scan | kruskal | boruvka] [threads]
+   *                       [--graph file] [--save file]
+   *                       [--christofides] [--greedy]
+   *                       [--improve] [--neighbors k]
+   *       hamiltonian_MST --points file
+   *prim (the default) builds the MST with a heap in O(E log V); scan
+   *runs the original O(V E) edge-rescanning loop; kruskal radix sorts
+   *the edges on the given number of threads and joins components with
+   *a union-find; boruvka contracts components in parallel rounds on
+   *the given number of threads. The MST weight and basic-op count go to
+   *cerr so the backends can be compared. The graph is read
+   *from stdin straight into a CSRGraph, parsed on the given number of
+   *threads, and the MST and the circuit are computed on contiguous
+   *arrays. --graph reads it instead from a file, either text in the
+   *same format or a binary CSRGraph file that is mapped in place.
+   *--save writes the graph out as a binary file. The circuit is the
+   *MST's depth-first preorder from vertex 0, closed back to it, with
+   *every step weighed by an O(1) EdgeWeights lookup. A step that is not
+   *an edge of the graph adds nothing, and the length line then says it
+   *is incomplete and how many such steps there were. --christofides
+   *builds it instead from the MST plus a minimum-weight matching of its
+   *odd-degree vertices, and --greedy does so with a greedy matching,
+   *which is the one used anyway past Christofides::EXACT_LIMIT odd
+   *vertices. --improve then shortens the circuit with 2-opt and Or-opt
+   *moves toward each vertex's k nearest neighbours (8 unless
+   *--neighbors says otherwise) and reports the gain and the time taken
+   *to cerr. --points reads instead a text file of "x y" pairs and takes
+   *the graph to be the complete graph on them with Euclidean distances,
+   *rounded, as weights: the MST then comes from EuclideanMST's O(V^2)
+   *array Prim, which computes distances as it goes and stores no edges,
+   *and the twice-around walk looks them up the same way, so memory stays
+   *O(V). It does not combine with the options that need the graph's
+   *edges
    *@author Garrett Money
    *@version May 8, 2018
   */
 
+#include <chrono>
 #include <climits>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
 #include <iostream>
-#include <list>
 #include <vector>
-#include "graph_helpers.h"
+#include "christofides.h"
+#include "csr_graph.h"
+#include "edge_weights.h"
+#include "euclidean_mst.h"
+#include "graph_io.h"
+#include "local_search.h"
+#include "mst.h"
+#include "point_io.h"
+#include "twice_around.h"
 
 using namespace std;
 
-/**
- *This function takes multiple parameters and runs through the edges
- *of a given vertex. If we haven't seen it, we add it to our hamiltonian
- *vector and mark it as read
- *
- *@param source_graph the current graph being passed
- *@param edge the edge we are iterating on
- *@param hamiltonian the vector we are storing our progress in
- *@param length the combined weights of our progress
- *@param read which vertices we have read
- *@param found informs of a hit
- *@param vertex the current vertex we are on
- */
-void insertHamil( vector< list< Edge >> &source_graph,
-	     list< Edge >::iterator &it, size_t &edge,
-	     vector < uint > &hamiltonian, uint &length,
-	     vector <bool> &read, bool &found, size_t &vertex );
-
 /**
  *This prints out our calculated path and total weight of path
  *
  *@param hamil is the hamiltonian circuit we have calculated
  *@param length is the total weight of the hamiltonian path
+ *@param missing is the number of its steps that are not edges of the
+ *graph, which the length leaves out
  */
-void print( vector <uint> hamil, uint length);
-
-int main ()
-{
-
-  vector< list < Edge >> graph;
-  vector< Edge > all_edges;
-
-  read_adjacency_lists( graph, all_edges);
-  print_graph( graph );
-
-  // implement prim's algorithm for mst, hard-coded to start at vertex 0
-  vector< list< Edge >> mst;
-  vector< bool > known;
+void print( vector <uint> hamil, uint64_t length, size_t missing = 0 );
 
-  for( size_t i = 0; i < graph.size(); i++ )
-  {
-    list< Edge > empty_list;
-    mst.push_back( empty_list );
-    known.push_back( false );
-  }
-
-  known.at( 0 ) = true;
+/**
+ *Counts the steps of a circuit that are not edges of the graph
+ *
+ *@param hamil is the hamiltonian circuit
+ *@param weights is the weight lookup of the graph
+ *@return the number of missing steps
+ */
+size_t missing_steps( const vector< uint > & hamil, EdgeWeights & weights );
 
-  Edge max_weight_edge;
-  max_weight_edge.start_vertex = UINT_MAX;
-  max_weight_edge.end_vertex = UINT_MAX;
-  max_weight_edge.weight = UINT_MAX;
+/**
+ *Runs twice around on the complete Euclidean graph on a set of points
+ *
+ *@param path is the text file of points
+ *@return the exit status
+ */
+int points_twice_around( const char * path );
 
-  // do this once for each vertex after 0
-  // i is irrelevant
-  for( size_t i = 1; i < graph.size(); i++ )
+int main( int argc, char * argv[] )
+{
+  MST::Algorithm algorithm = MST::Algorithm::PRIM;
+  const char * name = "prim";
+  unsigned threads = 1;
+  bool improve = false;
+  size_t neighbors = 8;
+  bool christofides = false;
+  const char * graph_path = nullptr;
+  const char * save_path = nullptr;
+  const char * points_path = nullptr;
+  Christofides::Matching matching = Christofides::Matching::EXACT;
+  int positional = 0;
+  bool valid = true;
+  for( int i = 1; i < argc; i++ )
   {
-    // get shortest-distance edge from known to unknown vertices
-    Edge shortest_edge = max_weight_edge;
-    for( auto edge : all_edges )
+    if( strcmp( argv[ i ], "--improve" ) == 0 )
     {
-      if( known.at( edge.start_vertex )
-          && !known.at( edge.end_vertex)
-          && edge < shortest_edge )
-      {
-        shortest_edge = edge;
-      }
+      improve = true;
     }
+    else if( strcmp( argv[ i ], "--christofides" ) == 0 )
+    {
+      christofides = true;
+    }
+    else if( strcmp( argv[ i ], "--greedy" ) == 0 )
+    {
+      christofides = true;
+      matching = Christofides::Matching::GREEDY;
+    }
+    else if( strcmp( argv[ i ], "--graph" ) == 0 && i + 1 < argc )
+    {
+      graph_path = argv[ ++i ];
+    }
+    else if( strcmp( argv[ i ], "--save" ) == 0 && i + 1 < argc )
+    {
+      save_path = argv[ ++i ];
+    }
+    else if( strcmp( argv[ i ], "--points" ) == 0 && i + 1 < argc )
+    {
+      points_path = argv[ ++i ];
+    }
+    else if( strcmp( argv[ i ], "--neighbors" ) == 0 && i + 1 < argc )
+    {
+      improve = true;
+      neighbors = strtoul( argv[ ++i ], nullptr, 10 );
+    }
+    else if( positional == 0 )
+    {
+      name = argv[ i ];
+      positional++;
+    }
+    else if( positional == 1 )
+    {
+      threads = strtoul( argv[ i ], nullptr, 10 );
+      positional++;
+    }
+    else
+    {
+      valid = false;
+    }
+  }
+  if( points_path != nullptr && ( positional > 0 || christofides || improve
+                                  || graph_path != nullptr
+                                  || save_path != nullptr ) )
+    valid = false;
+  if( !valid )
+    name = "";
+  if( strcmp( name, "scan" ) == 0 )
+    algorithm = MST::Algorithm::PRIM_SCAN;
+  else if( strcmp( name, "kruskal" ) == 0 )
+    algorithm = MST::Algorithm::KRUSKAL;
+  else if( strcmp( name, "boruvka" ) == 0 )
+    algorithm = MST::Algorithm::BORUVKA;
+  else if( strcmp( name, "prim" ) != 0 )
+  {
+    cerr << "usage: " << argv[ 0 ]
+         << " [prim | scan | kruskal | boruvka] [threads]"
+         << " [--graph file] [--save file] [--christofides] [--greedy]"
+         << " [--improve] [--neighbors k]" << endl
+         << "       " << argv[ 0 ] << " --points file" << endl;
+    return 1;
+  }
+  if( points_path != nullptr )
+    return points_twice_around( points_path );
 
-    // add this edge and its reverse to mst
-    Edge other_direction;
-    other_direction.start_vertex = shortest_edge.end_vertex;
-    other_direction.end_vertex = shortest_edge.start_vertex;
-    other_direction.weight = shortest_edge.weight;
-
-    mst.at( shortest_edge.start_vertex ).push_back( shortest_edge );
-    mst.at( shortest_edge.end_vertex ).push_back( other_direction );
-    known.at( shortest_edge.end_vertex ) = true;
-
-    // go through and remove all edges from a known to a known vertex
-    // this is not essential but results in fewer basic operations
-    vector< Edge > edges_to_keep;
-    for( auto edge : all_edges )
+  // the graph is in CSR form from the start
+  CSRGraph csr;
+  if( graph_path != nullptr )
+  {
+    if( !load_graph( graph_path, csr, threads ) )
     {
-      if( !known.at( edge.start_vertex ) || !known.at( edge.end_vertex ))
-      {
-        edges_to_keep.push_back( edge );
-      }
+      cerr << "cannot load the graph in " << graph_path << endl;
+      return 1;
     }
-    all_edges = edges_to_keep;
   }
+  else if( !read_text_graph( stdin, csr, threads ) )
+  {
+    cerr << "cannot read the graph from stdin" << endl;
+    return 1;
+  }
+  if( save_path != nullptr && !csr.save( save_path ) )
+  {
+    cerr << "cannot save the graph to " << save_path << endl;
+    return 1;
+  }
+
+  // step one of twice around: the minimum spanning tree
+  CSRGraph mst;
+  MST engine( algorithm, threads );
+  engine.compute( csr, mst );
+  cerr << name << " mst weight: " << engine.get_weight()
+       << ", basic operations: " << engine.get_op_count() << endl;
   
   //---------------STEPS TWO AND THREE OF TWICE AROUND----------------
-  
-  //used to track iterations we have read
-  vector <bool> read;
 
-  //used to store final hamiltonian circuit
+  //walk the mst in preorder, shortcutting vertices already listed, or
+  //walk the mst plus a matching of its odd vertices
   vector < uint > hamiltonian;
-  uint length = 0;
-
-  //initialize
-  hamiltonian.push_back( mst.at( 0 ).begin()->start_vertex );
-
-  //initialize what we have read to nothing/false
-  for( size_t vert = 0; vert < mst.size(); vert++)
+  EdgeWeights weights( csr );
+  uint64_t length;
+  if( christofides )
   {
-    //we know the first one
-    if( vert == 0 )
-      read.push_back( true );
-    else
-      read.push_back( false );
+    Christofides builder( matching );
+    builder.compute( csr, mst, weights, 0, hamiltonian );
+    length = builder.get_length();
+    cerr << "christofides: " << builder.get_odd_count() << " odd vertices, "
+         << ( builder.get_matching() == Christofides::Matching::EXACT
+              ? "exact" : "greedy" )
+         << " matching weight " << builder.get_matching_weight()
+         << ", basic operations: " << builder.get_op_count() << endl;
   }
-
-  //run through mst and create the circuit
-  for( size_t vert = 0; vert < mst.size(); vert++ )
+  else
   {
-    //list of edge iterators for mst and graph
-    list< Edge >::iterator graph_iterator = graph.at( vert ).begin();
-    list< Edge >::iterator mst_iterator = mst.at( vert ).begin();
-
-    //keeps track of edge and hit
-    bool hit = false;
-    size_t edge = 0;
-
-    //run through edges
-    insertHamil( mst, mst_iterator, edge, hamiltonian, length, read,
-		 hit, vert );
-    if( hit == false )
-    {
-      insertHamil( graph, graph_iterator, edge, hamiltonian, length, read,
-		   hit, vert );
-    }
+    TwiceAround walk;
+    walk.compute( mst, weights, 0, hamiltonian );
+    length = walk.get_length();
+    cerr << "twice around basic operations: " << walk.get_op_count()
+         << endl;
+  }
+  //optionally shorten it with 2-opt and Or-opt moves
+  if( improve )
+  {
+    LocalSearch search( neighbors );
+    auto start = chrono::steady_clock::now();
+    search.compute( csr, weights, hamiltonian );
+    chrono::duration< double > elapsed = chrono::steady_clock::now() - start;
+    length = search.get_length();
+    double saved = search.get_initial_length() == 0 ? 0 :
+      100.0 * ( double( search.get_initial_length() ) - length )
+      / search.get_initial_length();
+    cerr << "local search: " << search.get_initial_length() << " -> "
+         << length << " (" << fixed << setprecision( 2 ) << saved
+         << "% shorter), " << search.get_moves() << " moves, "
+         << setprecision( 4 ) << elapsed.count() << " s, basic operations: "
+         << search.get_op_count() << endl;
   }
 
-  //add the edge 
-  list< Edge >::iterator it = graph.at( graph.size() - 1 ).begin();
-  while( it->end_vertex != hamiltonian.at( 0 ) )
+  //print the results, with any steps the length leaves out
+  print( hamiltonian, length, missing_steps( hamiltonian, weights ) );
+  return 0;
+}
+
+int points_twice_around( const char * path )
+{
+  vector< int > xcoords;
+  vector< int > ycoords;
+  if( !load_text_points( path, xcoords, ycoords ) )
   {
-    it++;
+    cerr << "cannot read points from " << path << endl;
+    return 1;
   }
-  length = length + it->weight;
-  hamiltonian.push_back( it->end_vertex );
 
-  //print the results
-  print( hamiltonian, length );
+  // the tree and the walk both weigh steps from the coordinates
+  CSRGraph mst;
+  EuclideanMST engine;
+  engine.compute( xcoords, ycoords, mst );
+  cerr << "euclidean mst weight: " << engine.get_weight()
+       << ", basic operations: " << engine.get_op_count() << endl;
+
+  vector < uint > hamiltonian;
+  EdgeWeights weights( xcoords, ycoords );
+  TwiceAround walk;
+  walk.compute( mst, weights, 0, hamiltonian );
+  cerr << "twice around basic operations: " << walk.get_op_count() << endl;
+  print( hamiltonian, walk.get_length() );
   return 0;
 }
 
-void insertHamil( vector< list< Edge >> &source_graph,
-	     list< Edge >::iterator &it, size_t &edge,
-	     vector < uint > &hamil, uint &length,
-	     vector <bool> &read, bool &found, size_t &vertex )
+size_t missing_steps( const vector< uint > & hamil, EdgeWeights & weights )
 {
-   for(; edge < source_graph.at( vertex ).size(); edge++)
-   {
-      //if it's new, add it and mark it as read, then add the weight
-      if( read.at( it->end_vertex ) == false )
-      {
-         hamil.push_back( it->end_vertex );
-	 found = true;
-         read.at( it->end_vertex ) = true;
-	 length = length + it->weight;
-         break;
-      }
-      it++;
-   }
+  size_t missing = 0;
+  for( size_t i = 0; i + 1 < hamil.size(); i++ )
+  {
+    if( hamil[ i ] != hamil[ i + 1 ]
+        && weights.get( hamil[ i ], hamil[ i + 1 ] ) == EdgeWeights::ABSENT )
+      missing++;
+  }
+  return missing;
 }
 
-void print( vector <uint> hamil, uint length)
+void print( vector <uint> hamil, uint64_t length, size_t missing )
 {
    cout << "Hamiltonian circuit: ";
    for( size_t i = 0; i < hamil.size(); i++)
@@ -194,5 +297,9 @@ void print( vector <uint> hamil, uint length)
      else
        cout << " " << hamil.at( i ) << ",";
    }
-   cout << "\ncircuit length: " << length << endl;
+   cout << "\ncircuit length: " << length;
+   if( missing > 0 )
+     cout << " (incomplete: " << missing << " of " << hamil.size() - 1
+          << " steps are not edges of the graph and are not counted)";
+   cout << endl;
 }
@@ -0,0 +1,266 @@
+#ifndef MONEY_HASH_ANALYSIS
+#define MONEY_HASH_ANALYSIS
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "hash_functions.h"
+
+/**
+ * Collision-quality analysis for a set of hash functions over a set of
+ * table sizes, gathered in a single pass over the keys.
+ *
+ * For every function and table size it keeps the load of every bucket
+ * and reports the bucket-load histogram, the maximum chain length, the
+ * number of empty buckets and Pearson's chi-square statistic against
+ * the uniform expectation of keys / table_size per bucket, with its
+ * z-score for table_size - 1 degrees of freedom (|z| well above 3
+ * means the function is measurably non-uniform). For every function it
+ * also runs an avalanche test on the first keys seen: each input bit
+ * is flipped in turn and the bits that change in the raw 64-bit hash,
+ * asked for with a table size of SIZE_MAX, are counted, so no table
+ * reduction mixes them first. An ideal function flips each output bit
+ * half the time.
+ * Results are written as CSV or JSON.
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+class HashAnalysis
+{
+ public:
+  /**
+   * The distribution of keys over one table
+   */
+  struct BucketReport
+  {
+    size_t table_size;
+    size_t keys;
+    size_t max_chain;
+    size_t empty_buckets;
+    double chi_square;
+    double chi_square_z;
+    std::vector< size_t > load_histogram; // buckets holding i keys
+  };
+
+  /**
+   * The avalanche behaviour of one function
+   */
+  struct AvalancheReport
+  {
+    size_t flips;      // single-bit input changes tried
+    double mean_flip;  // average fraction of output bits changed
+    double worst_bias; // largest |P(output bit changes) - 1/2|
+  };
+
+  /**
+   * Construct an analysis
+   * @param functions the hash functions to analyze
+   * @param table_sizes the table sizes to analyze each function at
+   * @param avalanche_keys how many of the first keys to avalanche test
+   */
+  HashAnalysis( const std::vector< NamedHash > & functions,
+                const std::vector< size_t > & table_sizes,
+                size_t avalanche_keys = 1000 )
+    : functions{ functions }, table_sizes{ table_sizes },
+      avalanche_keys{ avalanche_keys }, key_count{ 0 },
+      loads( functions.size() * table_sizes.size() ),
+      bit_changes( functions.size(), std::vector< size_t >( 64, 0 ) ),
+      flips( functions.size(), 0 )
+  {
+    for( size_t i = 0; i < loads.size(); i++ )
+    {
+      loads[ i ].assign( table_sizes[ i % table_sizes.size() ], 0 );
+    }
+  }
+
+  /**
+   * Hash one key with every function at every table size
+   * @param key the key to add
+   */
+  void add( const std::string & key )
+  {
+    for( size_t f = 0; f < functions.size(); f++ )
+    {
+      for( size_t t = 0; t < table_sizes.size(); t++ )
+      {
+        loads[ f * table_sizes.size() + t ]
+          [ functions[ f ].function( key, table_sizes[ t ] ) ]++;
+      }
+      if( key_count < avalanche_keys )
+        avalanche( f, key );
+    }
+    key_count++;
+  }
+
+  /**
+   * Accessor for the number of keys added
+   * @return the key count
+   */
+  size_t size() const
+  {
+    return key_count;
+  }
+
+  /**
+   * Summarize the bucket loads of one function at one table size
+   * @param function the index of the function
+   * @param table the index of the table size
+   * @return the report
+   */
+  BucketReport bucket_report( size_t function, size_t table ) const
+  {
+    const std::vector< uint32_t > & load =
+      loads[ function * table_sizes.size() + table ];
+    BucketReport report{ load.size(), key_count, 0, 0, 0.0, 0.0, {} };
+
+    for( auto keys : load )
+    {
+      if( keys >= report.load_histogram.size() )
+        report.load_histogram.resize( keys + 1, 0 );
+      report.load_histogram[ keys ]++;
+    }
+    report.max_chain = report.load_histogram.size() - 1;
+    report.empty_buckets = report.load_histogram[ 0 ];
+
+    double expected = double( key_count ) / load.size();
+    if( expected > 0 )
+    {
+      for( size_t keys = 0; keys < report.load_histogram.size(); keys++ )
+      {
+        double difference = keys - expected;
+        report.chi_square += report.load_histogram[ keys ] * difference
+          * difference / expected;
+      }
+      double freedom = load.size() > 1 ? load.size() - 1 : 1;
+      report.chi_square_z = ( report.chi_square - freedom )
+        / std::sqrt( 2 * freedom );
+    }
+    return report;
+  }
+
+  /**
+   * Summarize the avalanche test of one function
+   * @param function the index of the function
+   * @return the report
+   */
+  AvalancheReport avalanche_report( size_t function ) const
+  {
+    AvalancheReport report{ flips[ function ], 0.0, 0.0 };
+    if( report.flips == 0 )
+      return report;
+    for( auto changes : bit_changes[ function ] )
+    {
+      double probability = double( changes ) / report.flips;
+      report.mean_flip += probability / 64;
+      report.worst_bias = std::max( report.worst_bias,
+                                    std::fabs( probability - 0.5 ) );
+    }
+    return report;
+  }
+
+  /**
+   * Write one CSV row per function and table size, after a header row.
+   * The load histogram is the last field, as "keys:buckets" pairs
+   * separated by semicolons.
+   * @param out the stream to write to
+   */
+  void write_csv( std::ostream & out ) const
+  {
+    out << "function,table_size,keys,max_chain,empty_buckets,chi_square,"
+        << "chi_square_z,avalanche_flips,avalanche_mean,avalanche_worst_bias,"
+        << "load_histogram\n";
+    for( size_t f = 0; f < functions.size(); f++ )
+    {
+      AvalancheReport avalanche = avalanche_report( f );
+      for( size_t t = 0; t < table_sizes.size(); t++ )
+      {
+        BucketReport report = bucket_report( f, t );
+        out << functions[ f ].name << ',' << report.table_size << ','
+            << report.keys << ',' << report.max_chain << ','
+            << report.empty_buckets << ',' << report.chi_square << ','
+            << report.chi_square_z << ',' << avalanche.flips << ','
+            << avalanche.mean_flip << ',' << avalanche.worst_bias << ',';
+        for( size_t keys = 0; keys < report.load_histogram.size(); keys++ )
+        {
+          out << ( keys > 0 ? ";" : "" ) << keys << ':'
+              << report.load_histogram[ keys ];
+        }
+        out << '\n';
+      }
+    }
+  }
+
+  /**
+   * Write every report as one JSON object
+   * @param out the stream to write to
+   */
+  void write_json( std::ostream & out ) const
+  {
+    out << "{\"keys\":" << key_count << ",\"functions\":[";
+    for( size_t f = 0; f < functions.size(); f++ )
+    {
+      AvalancheReport avalanche = avalanche_report( f );
+      out << ( f > 0 ? "," : "" ) << "{\"name\":\"" << functions[ f ].name
+          << "\",\"avalanche\":{\"flips\":" << avalanche.flips
+          << ",\"mean_flip\":" << avalanche.mean_flip
+          << ",\"worst_bias\":" << avalanche.worst_bias << "},\"tables\":[";
+      for( size_t t = 0; t < table_sizes.size(); t++ )
+      {
+        BucketReport report = bucket_report( f, t );
+        out << ( t > 0 ? "," : "" ) << "{\"table_size\":" << report.table_size
+            << ",\"max_chain\":" << report.max_chain
+            << ",\"empty_buckets\":" << report.empty_buckets
+            << ",\"chi_square\":" << report.chi_square
+            << ",\"chi_square_z\":" << report.chi_square_z
+            << ",\"load_histogram\":[";
+        for( size_t keys = 0; keys < report.load_histogram.size(); keys++ )
+        {
+          out << ( keys > 0 ? "," : "" ) << report.load_histogram[ keys ];
+        }
+        out << "]}";
+      }
+      out << "]}";
+    }
+    out << "]}\n";
+  }
+
+ private:
+  std::vector< NamedHash > functions;
+  std::vector< size_t > table_sizes;
+  size_t avalanche_keys;
+  size_t key_count;
+  std::vector< std::vector< uint32_t > > loads; // per function and size
+  std::vector< std::vector< size_t > > bit_changes; // per output bit
+  std::vector< size_t > flips;
+
+  /**
+   * Flip every bit of key in turn and count the bits of the raw,
+   * unreduced hash that change
+   */
+  void avalanche( size_t function, const std::string & key )
+  {
+    auto hash = functions[ function ].function;
+    uint64_t original = hash( key, SIZE_MAX );
+    std::string flipped = key;
+    for( size_t byte = 0; byte < key.size(); byte++ )
+    {
+      for( int bit = 0; bit < 8; bit++ )
+      {
+        flipped[ byte ] ^= char( 1 << bit );
+        uint64_t changed = original ^ hash( flipped, SIZE_MAX );
+        flipped[ byte ] ^= char( 1 << bit );
+        for( ; changed != 0; changed &= changed - 1 )
+        {
+          bit_changes[ function ][ __builtin_ctzll( changed ) ]++;
+        }
+        flips[ function ]++;
+      }
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,150 @@
+/**
+ * benchmark harness for every function in hash_registry
+ *
+ * reads a word list, one word per line, and for each hash function
+ * reports its throughput in GB/s of key bytes and its first-slot
+ * collision count (as hashing_collisions.cpp counts them) both for a
+ * table of word_count slots and for the next power-of-two size. when
+ * the word list cannot be read, a fixed pseudo-random list of 99171
+ * words stands in for it so results stay comparable between runs
+ *
+ * usage: hash_bench [word file]
+ *
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "hash_functions.h"
+
+using namespace std;
+
+/**
+ * Read the word list, or build the stand-in list if it cannot be read
+ * @param path the word file
+ * @return the words
+ */
+vector< string > load_words( const string & path );
+
+/**
+ * Count the keys that land in an already occupied slot
+ * @param function the hash function
+ * @param words the keys
+ * @param table_size the number of slots
+ * @return the number of collisions
+ */
+size_t count_collisions( size_t ( *function )( const string &, size_t ),
+                         const vector< string > & words, size_t table_size );
+
+/**
+ * Hash every word repeatedly for a fixed time
+ * @param function the hash function
+ * @param words the keys
+ * @param table_size the table size passed to the function
+ * @return the throughput in GB/s of key bytes
+ */
+double throughput( size_t ( *function )( const string &, size_t ),
+                   const vector< string > & words, size_t table_size );
+
+int main( int argc, char * argv[] )
+{
+  vector< string > words = load_words( argc > 1 ? argv[ 1 ]
+                                       : "/usr/share/dict/words" );
+  size_t word_count = words.size();
+  size_t power_of_two = 1;
+  while( power_of_two < word_count )
+    power_of_two *= 2;
+
+  cout << "words: " << word_count << endl;
+  cout << left << setw( 18 ) << "function" << setw( 10 ) << "GB/s"
+       << setw( 14 ) << "collisions" << "collisions@" << power_of_two
+       << endl;
+  for( auto & hash : hash_registry() )
+  {
+    cout << left << setw( 18 ) << hash.name << setw( 10 ) << fixed
+         << setprecision( 3 )
+         << throughput( hash.function, words, word_count )
+         << setw( 14 ) << count_collisions( hash.function, words, word_count )
+         << count_collisions( hash.function, words, power_of_two ) << endl;
+  }
+  return 0;
+}
+
+vector< string > load_words( const string & path )
+{
+  vector< string > words;
+  ifstream file( path );
+  string current_word;
+  while( getline( file, current_word ) )
+  {
+    words.push_back( current_word );
+  }
+  if( !words.empty() )
+    return words;
+
+  cerr << "cannot read " << path << ", using generated words" << endl;
+  mt19937 generator( 320 );
+  uniform_int_distribution< int > length( 1, 14 );
+  uniform_int_distribution< int > letter( 'a', 'z' );
+  for( size_t i = 0; i < 99171; i++ )
+  {
+    current_word.assign( length( generator ), ' ' );
+    for( auto & character : current_word )
+    {
+      character = letter( generator );
+    }
+    words.push_back( current_word );
+  }
+  return words;
+}
+
+size_t count_collisions( size_t ( *function )( const string &, size_t ),
+                         const vector< string > & words, size_t table_size )
+{
+  vector< bool > occupied( table_size, false );
+  size_t collisions = 0;
+  for( auto & word : words )
+  {
+    size_t slot = function( word, table_size );
+    if( occupied[ slot ] )
+      collisions++;
+    else
+      occupied[ slot ] = true;
+  }
+  return collisions;
+}
+
+double throughput( size_t ( *function )( const string &, size_t ),
+                   const vector< string > & words, size_t table_size )
+{
+  size_t bytes_per_pass = 0;
+  for( auto & word : words )
+  {
+    bytes_per_pass += word.size();
+  }
+
+  // keep the results live so the calls cannot be optimized away
+  volatile size_t sink = 0;
+  size_t passes = 0;
+  auto start = chrono::steady_clock::now();
+  chrono::duration< double > elapsed( 0 );
+  while( elapsed.count() < 0.25 )
+  {
+    size_t combined = 0;
+    for( auto & word : words )
+    {
+      combined += function( word, table_size );
+    }
+    sink = sink + combined;
+    passes++;
+    elapsed = chrono::steady_clock::now() - start;
+  }
+  return double( bytes_per_pass ) * passes / elapsed.count() / 1e9;
+}
@@ -0,0 +1,360 @@
+#ifndef MONEY_HASH_FUNCTIONS
+#define MONEY_HASH_FUNCTIONS
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * String hash functions for hash tables of a given size. Each one
+ * returns a slot in [0, table_size); passing the largest size_t as the
+ * table size yields the full-width hash value.
+ *
+ * hash_320 and custom_hash_320 consume one byte per step and reduce
+ * with %, a division on every call. The functions after them hash
+ * eight bytes per step where they can and reduce with reduce_to_table:
+ * a mask for power-of-two sizes and a multiply-shift (fastrange)
+ * otherwise. hash_registry lists every function by name.
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+
+/**
+ *This function takes a word and calculates a key based off of the
+ *ASCII values of the individual letters
+ *@author Jon Beck
+ *@param key is the word read from the file
+ *@param table_size is the size of m, or the size of the hash table
+ *@return the calculated hash value
+ */
+inline size_t hash_320( const std::string & key, size_t table_size )
+{
+  size_t hash_val = 0;
+
+  for( auto character : key )
+  {
+    hash_val = 37 * hash_val + static_cast< unsigned char >( character );
+  }
+  return hash_val % table_size;
+}
+
+/**
+ *This function takes a word and calculates a key based off of the
+ *ASCII values of the individual letters
+ *source:
+ *  https://www.javamex.com/tutorials/collections/
+ *  hash_function_technical_2.shtml
+ *@param key is the word read from the file
+ *@param table_size is the size of m, or the size of the hash table
+ *@return the calculated hash value
+ */
+inline size_t custom_hash_320( const std::string & key, size_t table_size )
+{
+  size_t hash_val = 0;
+
+  for( auto character : key )
+  {
+    hash_val = ( hash_val << 5 ) - hash_val +
+      static_cast< unsigned char >( character );
+  }
+  return hash_val % table_size;
+}
+
+namespace hash_detail
+{
+  /**
+   * Read 8, 4 or 3 bytes without alignment requirements
+   */
+  inline uint64_t read64( const char * bytes )
+  {
+    uint64_t value;
+    memcpy( &value, bytes, sizeof( value ) );
+    return value;
+  }
+
+  inline uint64_t read32( const char * bytes )
+  {
+    uint32_t value;
+    memcpy( &value, bytes, sizeof( value ) );
+    return value;
+  }
+
+  inline uint64_t read_small( const char * bytes, size_t length )
+  {
+    const unsigned char * data = reinterpret_cast< const unsigned char * >(
+      bytes );
+    return ( uint64_t( data[ 0 ] ) << 16 ) |
+      ( uint64_t( data[ length >> 1 ] ) << 8 ) | data[ length - 1 ];
+  }
+
+  inline uint64_t rotate_left( uint64_t value, int bits )
+  {
+    return ( value << bits ) | ( value >> ( 64 - bits ) );
+  }
+
+  /**
+   * Multiply to 128 bits and fold the halves together
+   */
+  inline uint64_t mum( uint64_t a, uint64_t b )
+  {
+    unsigned __int128 product = ( unsigned __int128 )( a ) * b;
+    return uint64_t( product ) ^ uint64_t( product >> 64 );
+  }
+
+  const uint64_t XXH_PRIME_1 = 0x9E3779B185EBCA87ull;
+  const uint64_t XXH_PRIME_2 = 0xC2B2AE3D27D4EB4Full;
+  const uint64_t XXH_PRIME_3 = 0x165667B19E3779F9ull;
+  const uint64_t XXH_PRIME_4 = 0x85EBCA77C2B2AE63ull;
+  const uint64_t XXH_PRIME_5 = 0x27D4EB2F165667C5ull;
+
+  inline uint64_t xxh_round( uint64_t accumulator, uint64_t input )
+  {
+    accumulator += input * XXH_PRIME_2;
+    return rotate_left( accumulator, 31 ) * XXH_PRIME_1;
+  }
+
+  inline uint64_t xxh_merge( uint64_t accumulator, uint64_t value )
+  {
+    accumulator ^= xxh_round( 0, value );
+    return accumulator * XXH_PRIME_1 + XXH_PRIME_4;
+  }
+}
+
+/**
+ * Map a full-width hash onto [0, table_size) without division: mask
+ * the low bits when the size is a power of two, otherwise take the
+ * high word of hash * table_size (Lemire's fastrange). fastrange reads
+ * the high bits, which FNV-1a barely mixes for short keys, so the hash
+ * is first multiplied by the 64-bit golden ratio to carry its low bits
+ * upward (Fibonacci hashing). The largest size_t asks for the hash
+ * itself, unreduced, and a table has at least one slot
+ * @param hash the full-width hash value
+ * @param table_size the size of the hash table, or SIZE_MAX
+ * @return the slot for the hash
+ */
+inline size_t reduce_to_table( uint64_t hash, size_t table_size )
+{
+  assert( table_size > 0 );
+  if( table_size == SIZE_MAX )
+    return hash;
+  if( ( table_size & ( table_size - 1 ) ) == 0 )
+    return hash & ( table_size - 1 );
+  hash *= 0x9e3779b97f4a7c15ull;
+  return size_t( ( ( unsigned __int128 )( hash ) * table_size ) >> 64 );
+}
+
+/**
+ * 64-bit FNV-1a, one byte per step
+ * @param bytes the key
+ * @param length the length of the key in bytes
+ * @return the 64-bit hash
+ */
+inline uint64_t fnv1a_64( const char * bytes, size_t length )
+{
+  uint64_t hash = 0xcbf29ce484222325ull;
+  for( size_t i = 0; i < length; i++ )
+  {
+    hash ^= static_cast< unsigned char >( bytes[ i ] );
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+/**
+ * xxHash64: four independent accumulators over 32-byte stripes, then
+ * eight, four and single bytes, then an avalanche
+ * @param bytes the key
+ * @param length the length of the key in bytes
+ * @param seed selects one of a family of independent hashes
+ * @return the 64-bit hash
+ */
+inline uint64_t xxh64( const char * bytes, size_t length, uint64_t seed = 0 )
+{
+  using namespace hash_detail;
+  const char * end = bytes + length;
+  uint64_t hash;
+
+  if( length >= 32 )
+  {
+    uint64_t v1 = seed + XXH_PRIME_1 + XXH_PRIME_2;
+    uint64_t v2 = seed + XXH_PRIME_2;
+    uint64_t v3 = seed;
+    uint64_t v4 = seed - XXH_PRIME_1;
+    for( ; bytes + 32 <= end; bytes += 32 )
+    {
+      v1 = xxh_round( v1, read64( bytes ) );
+      v2 = xxh_round( v2, read64( bytes + 8 ) );
+      v3 = xxh_round( v3, read64( bytes + 16 ) );
+      v4 = xxh_round( v4, read64( bytes + 24 ) );
+    }
+    hash = rotate_left( v1, 1 ) + rotate_left( v2, 7 ) +
+      rotate_left( v3, 12 ) + rotate_left( v4, 18 );
+    hash = xxh_merge( hash, v1 );
+    hash = xxh_merge( hash, v2 );
+    hash = xxh_merge( hash, v3 );
+    hash = xxh_merge( hash, v4 );
+  }
+  else
+  {
+    hash = seed + XXH_PRIME_5;
+  }
+  hash += length;
+
+  for( ; bytes + 8 <= end; bytes += 8 )
+  {
+    hash ^= xxh_round( 0, read64( bytes ) );
+    hash = rotate_left( hash, 27 ) * XXH_PRIME_1 + XXH_PRIME_4;
+  }
+  if( bytes + 4 <= end )
+  {
+    hash ^= read32( bytes ) * XXH_PRIME_1;
+    hash = rotate_left( hash, 23 ) * XXH_PRIME_2 + XXH_PRIME_3;
+    bytes += 4;
+  }
+  for( ; bytes < end; bytes++ )
+  {
+    hash ^= static_cast< unsigned char >( *bytes ) * XXH_PRIME_5;
+    hash = rotate_left( hash, 11 ) * XXH_PRIME_1;
+  }
+
+  hash ^= hash >> 33;
+  hash *= XXH_PRIME_2;
+  hash ^= hash >> 29;
+  hash *= XXH_PRIME_3;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+/**
+ * A wyhash-style hash: keys up to 16 bytes are read as two
+ * overlapping words, longer keys 16 bytes per step, and every step is
+ * a 64x64 to 128-bit multiply folded back to 64 bits
+ * @param bytes the key
+ * @param length the length of the key in bytes
+ * @return the 64-bit hash
+ */
+inline uint64_t wyhash_64( const char * bytes, size_t length )
+{
+  using namespace hash_detail;
+  const uint64_t secret[ 4 ] = { 0xa0761d6478bd642full, 0xe7037ed1a0b428dbull,
+                                 0x8ebc6af09c88c6e3ull, 0x589965cc75374cc3ull };
+  uint64_t seed = mum( secret[ 0 ], secret[ 1 ] );
+  uint64_t a;
+  uint64_t b;
+
+  if( length <= 16 )
+  {
+    if( length >= 4 )
+    {
+      size_t middle = ( length >> 3 ) << 2;
+      a = ( read32( bytes ) << 32 ) | read32( bytes + middle );
+      b = ( read32( bytes + length - 4 ) << 32 ) |
+        read32( bytes + length - 4 - middle );
+    }
+    else if( length > 0 )
+    {
+      a = read_small( bytes, length );
+      b = 0;
+    }
+    else
+    {
+      a = b = 0;
+    }
+  }
+  else
+  {
+    size_t remaining = length;
+    const char * position = bytes;
+    if( remaining > 48 )
+    {
+      uint64_t lane1 = seed;
+      uint64_t lane2 = seed;
+      for( ; remaining > 48; remaining -= 48, position += 48 )
+      {
+        seed = mum( read64( position ) ^ secret[ 1 ],
+                    read64( position + 8 ) ^ seed );
+        lane1 = mum( read64( position + 16 ) ^ secret[ 2 ],
+                     read64( position + 24 ) ^ lane1 );
+        lane2 = mum( read64( position + 32 ) ^ secret[ 3 ],
+                     read64( position + 40 ) ^ lane2 );
+      }
+      seed ^= lane1 ^ lane2;
+    }
+    for( ; remaining > 16; remaining -= 16, position += 16 )
+    {
+      seed = mum( read64( position ) ^ secret[ 1 ],
+                  read64( position + 8 ) ^ seed );
+    }
+    a = read64( position + remaining - 16 );
+    b = read64( position + remaining - 8 );
+  }
+
+  a ^= secret[ 1 ];
+  b ^= seed;
+  unsigned __int128 product = ( unsigned __int128 )( a ) * b;
+  return mum( uint64_t( product ) ^ secret[ 0 ] ^ length,
+              uint64_t( product >> 64 ) ^ secret[ 1 ] );
+}
+
+/**
+ *FNV-1a reduced to the table without division
+ *@param key is the word read from the file
+ *@param table_size is the size of m, or the size of the hash table
+ *@return the calculated hash value
+ */
+inline size_t fnv1a_320( const std::string & key, size_t table_size )
+{
+  return reduce_to_table( fnv1a_64( key.data(), key.size() ), table_size );
+}
+
+/**
+ *xxHash64 reduced to the table without division
+ *@param key is the word read from the file
+ *@param table_size is the size of m, or the size of the hash table
+ *@return the calculated hash value
+ */
+inline size_t xxh64_320( const std::string & key, size_t table_size )
+{
+  return reduce_to_table( xxh64( key.data(), key.size() ), table_size );
+}
+
+/**
+ *The wyhash-style hash reduced to the table without division
+ *@param key is the word read from the file
+ *@param table_size is the size of m, or the size of the hash table
+ *@return the calculated hash value
+ */
+inline size_t wyhash_320( const std::string & key, size_t table_size )
+{
+  return reduce_to_table( wyhash_64( key.data(), key.size() ), table_size );
+}
+
+/**
+ * A hash function and the name it is reported under
+ */
+struct NamedHash
+{
+  const char * name;
+  size_t ( *function )( const std::string &, size_t );
+};
+
+/**
+ * Every hash function in this file, in the order they are reported
+ * @return the registry
+ */
+inline const std::vector< NamedHash > & hash_registry()
+{
+  static const std::vector< NamedHash > registry = {
+    { "hash_320", hash_320 },
+    { "custom_hash_320", custom_hash_320 },
+    { "fnv1a", fnv1a_320 },
+    { "xxh64", xxh64_320 },
+    { "wyhash", wyhash_320 }
+  };
+  return registry;
+}
+
+#endif
@@ -0,0 +1,395 @@
+#ifndef MONEY_HASH_MAP
+#define MONEY_HASH_MAP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#if defined( __SSE2__ )
+#include <emmintrin.h>
+#endif
+
+/**
+ * An open-addressing hash map in the SwissTable style, templated on a
+ * hash function with the signature of hash_320 so any function from
+ * hash_functions.h plugs in.
+ *
+ * Slots are grouped 16 at a time, and each slot has a control byte:
+ * empty, deleted, or the low 7 bits of the key's hash. A lookup scans
+ * a whole group's control bytes at once (one SSE2 compare) and only
+ * compares keys whose 7 hash bits match, so at the maximum load of 7/8
+ * nearly every lookup finishes in its first group. Groups are visited
+ * in triangular order, which reaches every group of a power-of-two
+ * table. The full hash is requested by passing the largest size_t as
+ * the table size and is then mixed, so weak low bits do not cluster.
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+template< typename Key, typename Value,
+          size_t ( *Hash )( const Key &, size_t ) >
+class HashMap
+{
+ public:
+  /**
+   * Probe counters for the lookups made so far. A probe is one group
+   * of 16 control bytes examined; a comparison is one key compared.
+   */
+  struct ProbeStats
+  {
+    size_t lookups;
+    size_t probes;
+    size_t comparisons;
+    size_t max_probes;
+  };
+
+  /**
+   * Construct an empty map
+   * @param expected the number of entries to make room for
+   */
+  explicit HashMap( size_t expected = 0 )
+    : ctrl{ nullptr }, slots{ nullptr }, capacity{ 0 }, count{ 0 },
+      deleted{ 0 }, stats{ 0, 0, 0, 0 }
+  {
+    size_t wanted = GROUP;
+    while( wanted * 7 / 8 < expected )
+      wanted *= 2;
+    allocate( wanted );
+  }
+
+  HashMap( const HashMap & ) = delete;
+  HashMap & operator=( const HashMap & ) = delete;
+
+  /**
+   * The destructor destroys every entry and frees the table
+   */
+  ~HashMap()
+  {
+    release();
+  }
+
+  /**
+   * Insert a key and value if the key is not already present
+   * @param key the key to insert
+   * @param value the value to store with it
+   * @return true if inserted, false if the key was already present
+   */
+  bool insert( const Key & key, const Value & value )
+  {
+    if( count + deleted + 1 > capacity * 7 / 8 )
+      rehash( count + 1 > capacity * 7 / 16 ? capacity * 2 : capacity );
+
+    size_t hash = mix( Hash( key, SIZE_MAX ) );
+    size_t slot = 0;
+    if( locate( key, hash, slot ) )
+      return false;
+
+    if( ctrl[ slot ] == DELETED )
+      deleted--;
+    ctrl[ slot ] = int8_t( hash & 0x7f );
+    new( &slots[ slot ] ) Entry( key, value );
+    count++;
+    return true;
+  }
+
+  /**
+   * Find the value stored with a key
+   * @param key the key to look up
+   * @return a pointer to the value, or nullptr if the key is absent
+   */
+  Value * find( const Key & key )
+  {
+    size_t slot = 0;
+    if( locate( key, mix( Hash( key, SIZE_MAX ) ), slot ) )
+      return &slots[ slot ].second;
+    return nullptr;
+  }
+
+  /**
+   * Report whether a key is present
+   * @param key the key to look up
+   * @return true if the key is present
+   */
+  bool contains( const Key & key )
+  {
+    return find( key ) != nullptr;
+  }
+
+  /**
+   * Remove a key and its value
+   * @param key the key to remove
+   * @return true if the key was present
+   */
+  bool erase( const Key & key )
+  {
+    size_t slot = 0;
+    if( !locate( key, mix( Hash( key, SIZE_MAX ) ), slot ) )
+      return false;
+
+    slots[ slot ].~Entry();
+    count--;
+    // a group that still has an empty slot never let a probe pass it,
+    // so the slot can become empty again instead of a tombstone
+    if( match( slot / GROUP * GROUP, EMPTY ) != 0 )
+    {
+      ctrl[ slot ] = EMPTY;
+    }
+    else
+    {
+      ctrl[ slot ] = DELETED;
+      deleted++;
+    }
+    return true;
+  }
+
+  /**
+   * Accessor for the number of entries
+   * @return the number of keys stored
+   */
+  size_t size() const
+  {
+    return count;
+  }
+
+  /**
+   * Accessor to determine whether the map is empty
+   * @return true if no keys are stored
+   */
+  bool is_empty() const
+  {
+    return count == 0;
+  }
+
+  /**
+   * Accessor for the number of slots
+   * @return the table capacity
+   */
+  size_t get_capacity() const
+  {
+    return capacity;
+  }
+
+  /**
+   * Accessor for the fraction of slots in use
+   * @return the load factor
+   */
+  double load_factor() const
+  {
+    return double( count ) / capacity;
+  }
+
+  /**
+   * Accessor for the probe counters of every lookup so far, including
+   * those made by insert and erase
+   * @return the probe statistics
+   */
+  ProbeStats get_probe_stats() const
+  {
+    return stats;
+  }
+
+  /**
+   * Reset the probe counters to zero
+   */
+  void reset_probe_stats()
+  {
+    stats = ProbeStats{ 0, 0, 0, 0 };
+  }
+
+  /**
+   * The number of groups a successful lookup of each stored key would
+   * examine: entry i counts the keys found on their (i + 1)th probe
+   * @return the probe-length histogram of the current contents
+   */
+  std::vector< size_t > probe_histogram() const
+  {
+    std::vector< size_t > histogram;
+    size_t groups = capacity / GROUP;
+    for( size_t slot = 0; slot < capacity; slot++ )
+    {
+      if( ctrl[ slot ] < 0 )
+        continue;
+      size_t home = ( mix( Hash( slots[ slot ].first, SIZE_MAX ) ) >> 7 )
+        & ( groups - 1 );
+      size_t target = slot / GROUP;
+      size_t probes = 1;
+      for( size_t group = home, step = 1; group != target; step++ )
+      {
+        group = ( group + step ) & ( groups - 1 );
+        probes++;
+      }
+      if( histogram.size() < probes )
+        histogram.resize( probes, 0 );
+      histogram[ probes - 1 ]++;
+    }
+    return histogram;
+  }
+
+ private:
+  typedef std::pair< Key, Value > Entry;
+
+  static constexpr size_t GROUP = 16;
+  static constexpr int8_t EMPTY = -128;
+  static constexpr int8_t DELETED = -2;
+
+  int8_t * ctrl;
+  Entry * slots;
+  size_t capacity;
+  size_t count;
+  size_t deleted;
+  ProbeStats stats;
+
+  /**
+   * Spread the bits of a hash value with a 64-bit multiplicative mix
+   */
+  static size_t mix( size_t hash )
+  {
+    uint64_t mixed = uint64_t( hash ) * 0x9e3779b97f4a7c15ull;
+    return size_t( mixed ^ ( mixed >> 32 ) );
+  }
+
+  /**
+   * A bit mask with bit i set when control byte i of the group starting
+   * at slot first equals value
+   */
+  uint32_t match( size_t first, int8_t value ) const
+  {
+#if defined( __SSE2__ )
+    __m128i group = _mm_loadu_si128(
+      reinterpret_cast< const __m128i * >( ctrl + first ) );
+    return uint32_t( _mm_movemask_epi8(
+      _mm_cmpeq_epi8( group, _mm_set1_epi8( value ) ) ) );
+#else
+    uint32_t mask = 0;
+    for( size_t i = 0; i < GROUP; i++ )
+    {
+      if( ctrl[ first + i ] == value )
+        mask |= uint32_t( 1 ) << i;
+    }
+    return mask;
+#endif
+  }
+
+  /**
+   * Probe for key. If found, slot is its slot; otherwise slot is the
+   * first empty or deleted slot on its probe sequence, where it would
+   * be inserted.
+   * @return true if the key was found
+   */
+  bool locate( const Key & key, size_t hash, size_t & slot )
+  {
+    size_t groups = capacity / GROUP;
+    size_t group = ( hash >> 7 ) & ( groups - 1 );
+    int8_t tag = int8_t( hash & 0x7f );
+    bool have_free = false;
+    size_t probes = 0;
+
+    for( size_t step = 1; ; step++ )
+    {
+      probes++;
+      size_t first = group * GROUP;
+      for( uint32_t hits = match( first, tag ); hits != 0; hits &= hits - 1 )
+      {
+        size_t candidate = first + __builtin_ctz( hits );
+        stats.comparisons++;
+        if( slots[ candidate ].first == key )
+        {
+          slot = candidate;
+          record( probes );
+          return true;
+        }
+      }
+
+      if( !have_free )
+      {
+        uint32_t free = match( first, EMPTY ) | match( first, DELETED );
+        if( free != 0 )
+        {
+          slot = first + __builtin_ctz( free );
+          have_free = true;
+        }
+      }
+      if( match( first, EMPTY ) != 0 || step > groups )
+        break;
+      group = ( group + step ) & ( groups - 1 );
+    }
+    record( probes );
+    return false;
+  }
+
+  /**
+   * Add one lookup of the given probe length to the counters
+   */
+  void record( size_t probes )
+  {
+    stats.lookups++;
+    stats.probes += probes;
+    if( probes > stats.max_probes )
+      stats.max_probes = probes;
+  }
+
+  /**
+   * Allocate an empty table with the given number of slots
+   */
+  void allocate( size_t slot_count )
+  {
+    capacity = slot_count;
+    ctrl = new int8_t[ capacity ];
+    memset( ctrl, EMPTY, capacity );
+    slots = static_cast< Entry * >(
+      ::operator new( capacity * sizeof( Entry ) ) );
+    count = 0;
+    deleted = 0;
+  }
+
+  /**
+   * Destroy every entry and free the table
+   */
+  void release()
+  {
+    for( size_t slot = 0; slot < capacity; slot++ )
+    {
+      if( ctrl[ slot ] >= 0 )
+        slots[ slot ].~Entry();
+    }
+    delete [] ctrl;
+    ::operator delete( slots );
+  }
+
+  /**
+   * Move every entry into a fresh table with the given number of slots,
+   * dropping all tombstones
+   */
+  void rehash( size_t slot_count )
+  {
+    int8_t * old_ctrl = ctrl;
+    Entry * old_slots = slots;
+    size_t old_capacity = capacity;
+    ProbeStats saved = stats;
+
+    allocate( slot_count );
+    for( size_t slot = 0; slot < old_capacity; slot++ )
+    {
+      if( old_ctrl[ slot ] < 0 )
+        continue;
+      Entry & entry = old_slots[ slot ];
+      size_t hash = mix( Hash( entry.first, SIZE_MAX ) );
+      size_t target = 0;
+      locate( entry.first, hash, target );
+      ctrl[ target ] = int8_t( hash & 0x7f );
+      new( &slots[ target ] ) Entry( std::move( entry ) );
+      entry.~Entry();
+      count++;
+    }
+    stats = saved;
+
+    delete [] old_ctrl;
+    ::operator delete( old_slots );
+  }
+};
+
+#endif
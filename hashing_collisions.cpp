@@ -5,124 +5,319 @@
    *@version March 19, 2018
   */
 
+  #include <cassert>
   #include <cstdint>
+  #include <cstdlib>
+  #include <cstring>
   #include <iomanip>
   #include <iostream>
-  #include <fstream>
+  #include <string>
+  #include <vector>
+  #include "collision_counter.h"
+  #include "hash_analysis.h"
+  #include "hash_functions.h"
+  #include "hash_map.h"
+  #include "key_file.h"
+  #include "perfect_hash.h"
 
   using namespace std;
 
-  //prototypes for two separate hash functions
-  size_t hash_320( const string & key, size_t table_size );
-  size_t custom_hash_320( const string & key, size_t table_size );
-
   /**
-   *Main method to test two collisions for two different functions
-   *@returns 0
+   *Looks a key up in a minimal perfect hash, so it can be counted like
+   *any other function; its slots are exactly the table
+   *@param perfect_hash is the function to look in
+   *@param key is the word read from the file
+   *@param table_size is the size of m, which must be perfect_hash.size()
+   *@return the calculated hash value
    */
-  int main()
+  size_t perfect_hash_320( const PerfectHash & perfect_hash,
+                           const string & key, size_t table_size )
   {
-    //number of words in desired file found with wc -w <filename>
-    const size_t word_count = 99171;
+    assert( table_size == perfect_hash.size() );
+    static_cast< void >( table_size );
+    return perfect_hash.lookup( key );
+  }
 
-    //variables to count number of collisions for each hash function
-    size_t funct1_collisions = 0;
-    size_t funct2_collisions = 0;
+  /**
+   *Stores keys in a HashMap built on the given hash function until it is
+   *at its maximum load of 7/8, then looks every stored key up again and
+   *prints the probe statistics of those lookups on one line
+   *@param name is the label printed for the hash function
+   *@param keys is the key file, one key per line
+   */
+  template< size_t ( *Hash )( const string &, size_t ) >
+  void table_statistics( const string & name, KeyFile & keys );
 
-    //arrays to store whether or not a collision has occurred followed
-    size_t hash_table [ word_count ];
-    size_t custom_hash_table [ word_count ];
+  /**
+   *Runs a HashAnalysis of every registered hash function over the keys
+   *and writes it to cout
+   *@param keys is the key file, one key per line
+   *@param json selects JSON output instead of CSV
+   *@param table_sizes are the table sizes to analyze
+   */
+  void analyze( KeyFile & keys, bool json,
+                const vector< size_t > & table_sizes );
 
-    //stores the current word and the computed hash keys
-    string current_word;
-    size_t hash_key_1;
-    size_t hash_key_2;
+  /**
+   *Builds a minimal perfect hash of the keys and saves it, then maps
+   *the saved copy and counts its collisions over the keys at one slot
+   *per distinct key, which must be zero for a file without repeats
+   *@param keys is the key file, one key per line
+   *@param blob is the file to save the function to
+   *@param threads is the number of threads to count with
+   *@returns 0, or 1 if the function cannot be built, saved or mapped
+   */
+  int perfect( KeyFile & keys, const string & blob, unsigned threads );
 
-    //file declarations
-    ifstream file;
-    file.open( "/usr/share/dict/words" );
+  /**
+   *Parses a whole token as a positive count
+   *@param token is the command-line token
+   *@param value is set to the count
+   *@return false if the token is not a positive integer
+   */
+  bool parse_count( const char * token, size_t & value );
 
-    //initialize arrays to a number the key can never be
-    for( uint i = 0; i < word_count; i++ )
-    {
-      hash_table[ i ] = word_count + 1;
-      custom_hash_table[ i ] = word_count + 1;
-    }
+  /**
+   *Main method to test two collisions for two different functions.
+   *
+   *usage: hashing_collisions [all | table | analyze [csv | json] [size ...]
+   *                          | perfect [file]] [--keys file]
+   *                          [--load factor] [--threads n]
+   *
+   *The keys default to /usr/share/dict/words, one per line, and are
+   *memory-mapped, so key files of any size work. Each table gets
+   *keys / factor slots (factor defaults to 1, one slot per key), and
+   *the keys are split over n threads (default 1) with identical counts.
+   *"all" prints the collisions of every registered function, by name.
+   *"perfect" builds a minimal perfect hash of the keys, saves it to
+   *file (default words.mph) and counts the collisions of the saved copy.
+   *"table" prints the probe statistics of a HashMap on each function
+   *instead, filled with the keys to its maximum load, and "analyze"
+   *the bucket-load, chi-square and avalanche analysis of every
+   *registered function at the given table sizes (by default the
+   *load-factor size and the next power of two). The
+   *mode is the first token that is not an option; an unknown mode or a
+   *token that does not parse prints the usage
+   *@returns 0, or 1 on bad arguments or if the key file cannot be read
+   */
+  int main( int argc, char * argv[] )
+  {
+    string mode;
+    bool have_mode = false;
+    bool valid = true;
+    bool json = false;
+    vector< size_t > table_sizes;
+    string path = "/usr/share/dict/words";
+    string blob = "words.mph";
+    double load_factor = 1.0;
+    unsigned threads = 1;
 
-    //read from the file word by word and store into current_word
-    while( getline( file, current_word ) )
+    bool have_blob = false;
+    for( int arg = 1; arg < argc; arg++ )
     {
-      //call appropriate functions and store hashed value
-      hash_key_1 = hash_320( current_word, word_count );
-      hash_key_2 = custom_hash_320( current_word, word_count );
-
-      //if the hashed index is the first key there, update it
-      if( hash_table[ hash_key_1 ]  == ( word_count + 1 ) )
+      size_t count;
+      char * end;
+      if( strcmp( argv[ arg ], "--keys" ) == 0 && arg + 1 < argc )
+        path = argv[ ++arg ];
+      else if( strcmp( argv[ arg ], "--load" ) == 0 && arg + 1 < argc )
       {
-	hash_table[ hash_key_1 ] = hash_key_1;
+        load_factor = strtod( argv[ ++arg ], &end );
+        valid &= *end == '\0' && load_factor > 0;
       }
-      //if the value is not what the original was, a collision has occurred
-      else
+      else if( strcmp( argv[ arg ], "--threads" ) == 0 && arg + 1 < argc )
       {
-	funct1_collisions++;
+        valid &= parse_count( argv[ ++arg ], count );
+        threads = count;
       }
-
-      //if the hashed index is the first key there, update it 
-      if( custom_hash_table[ hash_key_2 ] == ( word_count + 1 ) )
+      else if( strncmp( argv[ arg ], "--", 2 ) == 0 )
+        valid = false;
+      else if( !have_mode )
       {
-	custom_hash_table[ hash_key_2 ] = hash_key_2;
+        mode = argv[ arg ];
+        have_mode = true;
       }
-      //if the value is not what the original was, a collision has occurred
+      else if( mode == "perfect" && !have_blob )
+      {
+        blob = argv[ arg ];
+        have_blob = true;
+      }
+      else if( mode == "analyze" && strcmp( argv[ arg ], "json" ) == 0 )
+        json = true;
+      else if( mode == "analyze" && strcmp( argv[ arg ], "csv" ) == 0 )
+        json = false;
+      else if( mode == "analyze" && parse_count( argv[ arg ], count ) )
+        table_sizes.push_back( count );
       else
+        valid = false;
+    }
+    if( have_mode && mode != "all" && mode != "table" && mode != "analyze"
+        && mode != "perfect" )
+      valid = false;
+    if( !valid )
+    {
+      cerr << "usage: " << argv[ 0 ] << " [all | table"
+           << " | analyze [csv | json] [size ...] | perfect [file]]"
+           << " [--keys file] [--load factor] [--threads n]" << endl;
+      return 1;
+    }
+
+    KeyFile keys( path );
+    if( !keys.is_open() || !( load_factor > 0 ) )
+    {
+      cerr << "cannot read keys from " << path << " at load factor "
+           << load_factor << endl;
+      return 1;
+    }
+
+    //size the tables from the number of keys instead of wc -w
+    size_t table_size = CollisionCounter::table_size_for( keys.key_count(),
+                                                          load_factor );
+
+    if( mode == "table" )
+    {
+      cout << "function size capacity load avg_probes max_probes "
+           << "avg_comparisons" << endl;
+      table_statistics< hash_320 >( "hash_320", keys );
+      table_statistics< custom_hash_320 >( "custom_hash_320", keys );
+      return 0;
+    }
+    if( mode == "analyze" )
+    {
+      if( table_sizes.empty() )
+      {
+        size_t power_of_two = 1;
+        while( power_of_two < table_size )
+          power_of_two *= 2;
+        table_sizes = { table_size, power_of_two };
+      }
+      analyze( keys, json, table_sizes );
+      return 0;
+    }
+
+    if( mode == "perfect" )
+      return perfect( keys, blob, threads );
+    if( mode == "all" )
+    {
+      //every function is evaluated in the same pass over the keys
+      CollisionCounter counter( hash_registry(), table_size, threads );
+      counter.add( keys );
+      for( size_t f = 0; f < counter.get_functions().size(); f++ )
       {
-	funct2_collisions++;
-      }  
+        cout << counter.get_functions()[ f ].name << ' '
+             << counter.collisions( f ) << endl;
+      }
+      return 0;
     }
 
+    //one occupancy bit per slot for each of the two functions
+    CollisionCounter counter( { { "hash_320", hash_320 },
+                                { "custom_hash_320", custom_hash_320 } },
+                              table_size, threads );
+    counter.add( keys );
+
     //print out the number of collisions for each function
-    cout << funct1_collisions << endl;
-    cout << funct2_collisions << endl;
+    cout << counter.collisions( 0 ) << endl;
+    cout << counter.collisions( 1 ) << endl;
     
     return 0;
   }
 
-  /**
-   *This function takes a word and calculates a key based off of the 
-   *ASCII values of the individual letters
-   *@author Jon Beck
-   *@param key is the word read from the file
-   *@param table_size is the size of m, or the size of the hash table
-   *@return the calculated hash value
-   */
-  size_t hash_320( const string & key, size_t table_size )
+  template< size_t ( *Hash )( const string &, size_t ) >
+  void table_statistics( const string & name, KeyFile & keys )
   {
-    size_t hash_val = 0;
+    //the largest power-of-two table the keys fill to 7/8, past which an
+    //insert would grow it; the keys after that are left out
+    size_t capacity = 16;
+    while( capacity * 2 * 7 / 8 <= keys.key_count() )
+      capacity *= 2;
+    size_t full = capacity * 7 / 8;
+    HashMap< string, size_t, Hash > table( full );
+    size_t line = 0;
+    size_t stored_lines = 0;
 
-    for( auto character : key )
-    {
-      hash_val = 37 * hash_val + static_cast< unsigned char >( character );
-    }
-    return hash_val % table_size;
+    //the key file may repeat keys; the table keeps the first
+    keys.for_each( [ &table, &line, &stored_lines, full ](
+                     const string & current_word )
+                   {
+                     if( table.size() < full )
+                     {
+                       table.insert( current_word, line );
+                       stored_lines = line + 1;
+                     }
+                     line++;
+                   } );
+
+    //measure only the lookups of stored keys
+    table.reset_probe_stats();
+    line = 0;
+    keys.for_each( [ &table, &line, stored_lines ](
+                     const string & current_word )
+                   {
+                     if( line++ < stored_lines )
+                       table.find( current_word );
+                   } );
+
+    auto stats = table.get_probe_stats();
+    double lookups = stats.lookups > 0 ? stats.lookups : 1;
+    cout << name << ' ' << table.size() << ' ' << table.get_capacity()
+         << ' ' << fixed << setprecision( 3 ) << table.load_factor()
+         << ' ' << stats.probes / lookups << ' ' << stats.max_probes
+         << ' ' << stats.comparisons / lookups << endl;
   }
 
-  /**
-   *This function takes a word and calculates a key based off of the 
-   *ASCII values of the individual letters
-   *source: 
-   *  https://www.javamex.com/tutorials/collections/
-   *  hash_function_technical_2.shtml
-   *@param key is the word read from the file
-   *@param table_size is the size of m, or the size of the hash table
-   *@return the calculated hash value
-   */
-  size_t custom_hash_320( const string & key, size_t table_size )
+  void analyze( KeyFile & keys, bool json,
+                const vector< size_t > & table_sizes )
+  {
+    HashAnalysis analysis( hash_registry(), table_sizes );
+
+    //every key is hashed once per function and table size
+    keys.for_each( [ &analysis ]( const string & current_word )
+                   {
+                     analysis.add( current_word );
+                   } );
+
+    if( json )
+      analysis.write_json( cout );
+    else
+      analysis.write_csv( cout );
+  }
+
+  int perfect( KeyFile & keys, const string & blob, unsigned threads )
   {
-    size_t hash_val = 0;
+    PerfectHash built;
+    if( !built.build( keys ) || !built.save( blob ) )
+    {
+      cerr << "cannot build and save a perfect hash to " << blob << endl;
+      return 1;
+    }
+    cout << "keys " << built.size() << " duplicates "
+         << built.get_duplicates() << " buckets " << built.get_bucket_count()
+         << " bits/key " << fixed << setprecision( 2 )
+         << built.bits_per_key() << " placements " << built.get_op_count()
+         << endl;
 
-    for( auto character : key )
+    //count with the mapped copy, as a program loading it at startup would
+    PerfectHash loaded;
+    if( !loaded.load( blob ) )
     {
-      hash_val = ( hash_val << 5 ) - hash_val +
-	static_cast< unsigned char >( character );
+      cerr << "cannot map a perfect hash from " << blob << endl;
+      return 1;
     }
-    return hash_val % table_size;
+    auto lookup = [ &loaded ]( const string & key, size_t table_size )
+      {
+        return perfect_hash_320( loaded, key, table_size );
+      };
+    typedef NamedCallable< decltype( lookup ) > Lookup;
+    BasicCollisionCounter< Lookup > counter( { { "perfect_hash", lookup } },
+                                             loaded.size(), threads );
+    counter.add( keys );
+    cout << "perfect_hash " << counter.collisions( 0 ) << endl;
+    return 0;
+  }
+
+  bool parse_count( const char * token, size_t & value )
+  {
+    char * end;
+    value = strtoul( token, &end, 10 );
+    return end != token && *end == '\0' && value > 0 && token[ 0 ] != '-';
   }
@@ -0,0 +1,280 @@
+#ifndef MONEY_HULL_KERNELS
+#define MONEY_HULL_KERNELS
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "orientation.h"
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+#define MONEY_HULL_X86 1
+#include <immintrin.h>
+#endif
+
+/**
+ * Data-parallel sign counting for the convex hull.
+ *
+ * count_signs classifies structure-of-arrays points against the
+ * directed line through two points in one pass, the inner loop of the
+ * brute-force hull. The vector kernels convert coordinates to double,
+ * where differences of ints are exact, and keep a lane's sign only
+ * when it clears the orient2d rounding-error bound; the rare uncertain
+ * lanes are settled by the exact predicate in orientation.h, so every
+ * kernel returns exactly the scalar counts. The best kernel for the
+ * running CPU (AVX2, SSE2, or portable scalar) is picked on first use.
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+
+/**
+ * The result of classifying points against a line
+ */
+struct SignCounts
+{
+  size_t positives; // points strictly left of the line
+  size_t negatives; // points strictly right of the line
+  size_t examined;  // points looked at before stopping
+};
+
+namespace hull_kernels
+{
+  typedef SignCounts ( *Kernel )( int, int, int, int, const int *,
+                                  const int *, size_t, bool );
+
+  /**
+   * The portable kernel, also used for the tail of the vector kernels
+   */
+  inline SignCounts count_signs_scalar( int x1, int y1, int x2, int y2,
+                                        const int * xs, const int * ys,
+                                        size_t n, bool stop_early )
+  {
+    SignCounts counts{ 0, 0, 0 };
+    for( size_t i = 0; i < n; i++ )
+    {
+      int sign = orientation( x1, y1, x2, y2, xs[ i ], ys[ i ] );
+      counts.positives += sign > 0;
+      counts.negatives += sign < 0;
+      if( stop_early && counts.positives != 0 && counts.negatives != 0 )
+      {
+        counts.examined = i + 1;
+        return counts;
+      }
+    }
+    counts.examined = n;
+    return counts;
+  }
+
+  /**
+   * The orient2d error bound factor for exact double differences
+   */
+  inline double error_bound()
+  {
+    const double epsilon = 1.1102230246251565e-16; // 2^-53
+    return ( 3.0 + 16.0 * epsilon ) * epsilon;
+  }
+
+#ifdef MONEY_HULL_X86
+  /**
+   * Settle the lanes in uncertain (one bit per lane) with the exact
+   * predicate and add their signs to counts
+   */
+  inline void settle_lanes( int uncertain, int x1, int y1, int x2, int y2,
+                            const int * xs, const int * ys,
+                            SignCounts & counts )
+  {
+    for( int lane = 0; uncertain != 0; lane++, uncertain >>= 1 )
+    {
+      if( uncertain & 1 )
+      {
+        int sign = orientation( x1, y1, x2, y2, xs[ lane ], ys[ lane ] );
+        counts.positives += sign > 0;
+        counts.negatives += sign < 0;
+      }
+    }
+  }
+
+  /**
+   * The SSE2 kernel, two points per step
+   */
+  __attribute__(( target( "sse2" ) ))
+  inline SignCounts count_signs_sse2( int x1, int y1, int x2, int y2,
+                                      const int * xs, const int * ys,
+                                      size_t n, bool stop_early )
+  {
+    SignCounts counts{ 0, 0, 0 };
+    const __m128d ax = _mm_set1_pd( x1 ), ay = _mm_set1_pd( y1 );
+    const __m128d dbx = _mm_set1_pd( double( x2 ) - x1 );
+    const __m128d dby = _mm_set1_pd( double( y2 ) - y1 );
+    const __m128d bound = _mm_set1_pd( error_bound() );
+    const __m128d abs_mask = _mm_castsi128_pd( _mm_set1_epi64x( INT64_MAX ) );
+
+    size_t i = 0;
+    for( ; i + 2 <= n; i += 2 )
+    {
+      __m128d cx = _mm_cvtepi32_pd(
+        _mm_loadl_epi64( reinterpret_cast< const __m128i * >( xs + i ) ) );
+      __m128d cy = _mm_cvtepi32_pd(
+        _mm_loadl_epi64( reinterpret_cast< const __m128i * >( ys + i ) ) );
+      __m128d left = _mm_mul_pd( dbx, _mm_sub_pd( cy, ay ) );
+      __m128d right = _mm_mul_pd( dby, _mm_sub_pd( cx, ax ) );
+      __m128d det = _mm_sub_pd( left, right );
+      __m128d error = _mm_mul_pd( bound, _mm_add_pd( _mm_and_pd( left, abs_mask ),
+                                                     _mm_and_pd( right, abs_mask ) ) );
+      int positive = _mm_movemask_pd( _mm_cmpgt_pd( det, error ) );
+      int negative = _mm_movemask_pd(
+        _mm_cmplt_pd( det, _mm_sub_pd( _mm_setzero_pd(), error ) ) );
+      counts.positives += __builtin_popcount( positive );
+      counts.negatives += __builtin_popcount( negative );
+
+      int uncertain = ~( positive | negative ) & 0x3;
+      if( uncertain )
+        settle_lanes( uncertain, x1, y1, x2, y2, xs + i, ys + i, counts );
+      if( stop_early && counts.positives != 0 && counts.negatives != 0 )
+      {
+        counts.examined = i + 2;
+        return counts;
+      }
+    }
+
+    SignCounts tail = count_signs_scalar( x1, y1, x2, y2, xs + i, ys + i,
+                                          n - i, false );
+    counts.positives += tail.positives;
+    counts.negatives += tail.negatives;
+    counts.examined = n;
+    return counts;
+  }
+
+  /**
+   * The AVX2 kernel, four points per step
+   */
+  __attribute__(( target( "avx2" ) ))
+  inline SignCounts count_signs_avx2( int x1, int y1, int x2, int y2,
+                                      const int * xs, const int * ys,
+                                      size_t n, bool stop_early )
+  {
+    SignCounts counts{ 0, 0, 0 };
+    const __m256d ax = _mm256_set1_pd( x1 ), ay = _mm256_set1_pd( y1 );
+    const __m256d dbx = _mm256_set1_pd( double( x2 ) - x1 );
+    const __m256d dby = _mm256_set1_pd( double( y2 ) - y1 );
+    const __m256d bound = _mm256_set1_pd( error_bound() );
+    const __m256d abs_mask =
+      _mm256_castsi256_pd( _mm256_set1_epi64x( INT64_MAX ) );
+
+    size_t i = 0;
+    for( ; i + 4 <= n; i += 4 )
+    {
+      __m256d cx = _mm256_cvtepi32_pd(
+        _mm_loadu_si128( reinterpret_cast< const __m128i * >( xs + i ) ) );
+      __m256d cy = _mm256_cvtepi32_pd(
+        _mm_loadu_si128( reinterpret_cast< const __m128i * >( ys + i ) ) );
+      __m256d left = _mm256_mul_pd( dbx, _mm256_sub_pd( cy, ay ) );
+      __m256d right = _mm256_mul_pd( dby, _mm256_sub_pd( cx, ax ) );
+      __m256d det = _mm256_sub_pd( left, right );
+      __m256d error = _mm256_mul_pd(
+        bound, _mm256_add_pd( _mm256_and_pd( left, abs_mask ),
+                              _mm256_and_pd( right, abs_mask ) ) );
+      int positive = _mm256_movemask_pd( _mm256_cmp_pd( det, error,
+                                                        _CMP_GT_OQ ) );
+      int negative = _mm256_movemask_pd(
+        _mm256_cmp_pd( det, _mm256_sub_pd( _mm256_setzero_pd(), error ),
+                       _CMP_LT_OQ ) );
+      counts.positives += __builtin_popcount( positive );
+      counts.negatives += __builtin_popcount( negative );
+
+      int uncertain = ~( positive | negative ) & 0xf;
+      if( uncertain )
+        settle_lanes( uncertain, x1, y1, x2, y2, xs + i, ys + i, counts );
+      if( stop_early && counts.positives != 0 && counts.negatives != 0 )
+      {
+        counts.examined = i + 4;
+        return counts;
+      }
+    }
+
+    SignCounts tail = count_signs_scalar( x1, y1, x2, y2, xs + i, ys + i,
+                                          n - i, false );
+    counts.positives += tail.positives;
+    counts.negatives += tail.negatives;
+    counts.examined = n;
+    return counts;
+  }
+#endif
+
+  /**
+   * Pick the widest kernel the running CPU supports
+   */
+  inline Kernel select_kernel()
+  {
+#ifdef MONEY_HULL_X86
+    __builtin_cpu_init();
+    if( __builtin_cpu_supports( "avx2" ) )
+      return count_signs_avx2;
+    if( __builtin_cpu_supports( "sse2" ) )
+      return count_signs_sse2;
+#endif
+    return count_signs_scalar;
+  }
+
+  /**
+   * The kernel chosen for this process, resolved once
+   */
+  inline Kernel & active_kernel()
+  {
+    static Kernel kernel = select_kernel();
+    return kernel;
+  }
+}
+
+/**
+ * Count the points on each side of the directed line from (x1, y1) to
+ * (x2, y2). Points on the line count on neither side.
+ * @param xs the x coordinates
+ * @param ys the y coordinates
+ * @param n the number of points
+ * @param stop_early stop as soon as both counts are nonzero
+ * @return the counts and how many points were examined
+ */
+inline SignCounts count_signs( int x1, int y1, int x2, int y2,
+                               const int * xs, const int * ys, size_t n,
+                               bool stop_early = true )
+{
+  return hull_kernels::active_kernel()( x1, y1, x2, y2, xs, ys, n,
+                                        stop_early );
+}
+
+/**
+ * Check a hull from any algorithm: the vertices must turn strictly
+ * counter-clockwise and every point must lie left of or on every edge.
+ * @param xcoords stores the x values in a vector
+ * @param ycoords stores the y values in a vector
+ * @param hull the hull vertex indices in counter-clockwise order
+ * @return true if the hull is valid
+ */
+inline bool validate_hull( const std::vector< int > & xcoords,
+                           const std::vector< int > & ycoords,
+                           const std::vector< size_t > & hull )
+{
+  size_t h = hull.size();
+  if( h < 3 )
+    return true;
+
+  for( size_t i = 0; i < h; i++ )
+  {
+    size_t a = hull[ i ];
+    size_t b = hull[ ( i + 1 ) % h ];
+    size_t c = hull[ ( i + 2 ) % h ];
+    if( orientation( xcoords[ a ], ycoords[ a ], xcoords[ b ], ycoords[ b ],
+                     xcoords[ c ], ycoords[ c ] ) <= 0 )
+      return false;
+
+    SignCounts counts = count_signs( xcoords[ a ], ycoords[ a ],
+                                     xcoords[ b ], ycoords[ b ],
+                                     xcoords.data(), ycoords.data(),
+                                     xcoords.size() );
+    if( counts.negatives != 0 )
+      return false;
+  }
+  return true;
+}
+
+#endif
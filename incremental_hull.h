@@ -0,0 +1,215 @@
+#ifndef MONEY_INCREMENTAL_HULL
+#define MONEY_INCREMENTAL_HULL
+
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <utility>
+#include <vector>
+#include "orientation.h"
+
+/**
+ * A convex hull that grows one point at a time, for input that never
+ * ends. The lower and upper chains are kept in balanced search trees
+ * keyed by x, so an insertion costs amortized O(log h) and memory is
+ * proportional to the number of hull vertices h, not the number of
+ * points seen. The hull can be read at any time.
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+template< typename Coord >
+class IncrementalHull
+{
+ public:
+  typedef std::pair< Coord, Coord > Point;
+
+  /**
+   * Construct an empty hull
+   */
+  IncrementalHull()
+    : lower{ false }, upper{ true }, point_count{ 0 }, op_count{ 0 } {}
+
+  /**
+   * Add one point to the hull
+   * @param x the x coordinate of the point
+   * @param y the y coordinate of the point
+   */
+  void insert( Coord x, Coord y )
+  {
+    point_count++;
+    lower.insert( x, y, op_count );
+    upper.insert( x, y, op_count );
+  }
+
+  /**
+   * Add a batch of points to the hull
+   * @param xcoords stores the x values in a vector
+   * @param ycoords stores the y values in a vector
+   */
+  void insert( const std::vector< Coord > & xcoords,
+               const std::vector< Coord > & ycoords )
+  {
+    assert( xcoords.size() == ycoords.size() );
+    for( size_t i = 0; i < xcoords.size(); i++ )
+    {
+      insert( xcoords[ i ], ycoords[ i ] );
+    }
+  }
+
+  /**
+   * Report whether the point lies inside or on the current hull
+   * @param x the x coordinate of the point
+   * @param y the y coordinate of the point
+   * @return true if the point is covered by the hull
+   */
+  bool contains( Coord x, Coord y )
+  {
+    return lower.covers( x, y, op_count ) && upper.covers( x, y, op_count );
+  }
+
+  /**
+   * The current hull vertices in counter-clockwise order, starting with
+   * the lowest leftmost point. O(h).
+   * @return the hull vertices
+   */
+  std::vector< Point > hull() const
+  {
+    std::vector< Point > vertices;
+    for( auto & vertex : lower.chain )
+    {
+      vertices.push_back( vertex );
+    }
+    for( auto itr = upper.chain.rbegin(); itr != upper.chain.rend(); itr++ )
+    {
+      // the ends of the chains meet at the leftmost and rightmost x
+      Point vertex( itr->first, itr->second );
+      if( vertex != vertices.back() && vertex != vertices.front() )
+        vertices.push_back( vertex );
+    }
+    return vertices;
+  }
+
+  /**
+   * Accessor for the number of points inserted so far
+   * @return the number of points seen
+   */
+  size_t size() const
+  {
+    return point_count;
+  }
+
+  /**
+   * Accessor to determine whether any point has been inserted
+   * @return true if no point has been inserted
+   */
+  bool is_empty() const
+  {
+    return point_count == 0;
+  }
+
+  /**
+   * Return the number of basic operations (orientation tests) so far
+   * @return the count of basic operations
+   */
+  size_t get_op_count() const
+  {
+    return op_count;
+  }
+
+ private:
+  /**
+   * One monotone half of the hull: the lower chain keeps the lowest
+   * point for each x and must turn counter-clockwise from left to
+   * right; the upper chain keeps the highest and turns clockwise.
+   */
+  class Chain
+  {
+   public:
+    explicit Chain( bool is_upper ) : is_upper{ is_upper } {}
+
+    /**
+     * Add a point, dropping it if the chain already covers it and
+     * removing any vertices it makes redundant
+     */
+    void insert( Coord x, Coord y, size_t & ops )
+    {
+      auto same = chain.find( x );
+      if( same != chain.end() )
+      {
+        if( is_upper ? same->second >= y : same->second <= y )
+          return;
+        chain.erase( same );
+      }
+      else if( covers( x, y, ops ) )
+      {
+        return;
+      }
+
+      auto point = chain.emplace( x, y ).first;
+
+      // remove vertices to the right that no longer turn strictly
+      while( true )
+      {
+        auto next = std::next( point );
+        if( next == chain.end() || std::next( next ) == chain.end() )
+          break;
+        if( turn( *point, *next, *std::next( next ), ops ) > 0 )
+          break;
+        chain.erase( next );
+      }
+
+      // and to the left
+      while( point != chain.begin() )
+      {
+        auto previous = std::prev( point );
+        if( previous == chain.begin() )
+          break;
+        if( turn( *std::prev( previous ), *previous, *point, ops ) > 0 )
+          break;
+        chain.erase( previous );
+      }
+    }
+
+    /**
+     * Report whether the point is on the inner side of, or on, the
+     * chain within its x range. Points outside the x range are not
+     * covered.
+     */
+    bool covers( Coord x, Coord y, size_t & ops ) const
+    {
+      auto next = chain.lower_bound( x );
+      if( next == chain.end() )
+        return false;
+      if( next->first == x )
+        return is_upper ? y <= next->second : y >= next->second;
+      if( next == chain.begin() )
+        return false;
+      auto previous = std::prev( next );
+      return turn( *previous, *next, Point( x, y ), ops ) >= 0;
+    }
+
+    /**
+     * The turn made by a, b, c, positive when it bends toward the
+     * inside of the hull
+     */
+    int turn( const Point & a, const Point & b, const Point & c,
+              size_t & ops ) const
+    {
+      ops++;
+      int sign = orientation( a.first, a.second, b.first, b.second,
+                              c.first, c.second );
+      return is_upper ? -sign : sign;
+    }
+
+    bool is_upper;
+    std::map< Coord, Coord > chain;
+  };
+
+  Chain lower;
+  Chain upper;
+  size_t point_count;
+  size_t op_count;
+};
+
+#endif
@@ -0,0 +1,154 @@
+#ifndef MONEY_KEY_FILE
+#define MONEY_KEY_FILE
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "mapped_file.h"
+
+/**
+ * A memory-mapped file of keys, one per line, as getline would split
+ * it: the newline is not part of the key and a final line without a
+ * newline is still a key. Keys are visited in place, so a key file of
+ * any size is streamed through the page cache rather than loaded.
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+class KeyFile
+{
+ public:
+  /**
+   * Map the named key file; check is_open before using it
+   * @param path the file to map
+   */
+  explicit KeyFile( const std::string & path )
+    : file{ path }, keys{ 0 }, counted{ false } {}
+
+  /**
+   * Accessor to determine whether the file was mapped
+   * @return true if the keys are available
+   */
+  bool is_open() const
+  {
+    return file.is_open();
+  }
+
+  /**
+   * Accessor for the size of the file
+   * @return the size in bytes
+   */
+  size_t size() const
+  {
+    return file.size();
+  }
+
+  /**
+   * The number of keys, counted with one memchr pass the first time
+   * @return the number of lines in the file
+   */
+  size_t key_count()
+  {
+    if( !counted )
+    {
+      keys = 0;
+      for_each_line( 0, file.size(),
+                     [ this ]( const char *, size_t ) { keys++; } );
+      counted = true;
+    }
+    return keys;
+  }
+
+  /**
+   * Split the file into byte ranges that each start on a line, so that
+   * for_each over every range visits every key exactly once
+   * @param parts the number of ranges wanted
+   * @return the range boundaries, from 0 to size(); ranges may be empty
+   */
+  std::vector< size_t > split( size_t parts ) const
+  {
+    std::vector< size_t > bounds{ 0 };
+    for( size_t part = 1; part < parts; part++ )
+    {
+      bounds.push_back( std::max( bounds.back(),
+                                  line_start( file.size() / parts * part ) ) );
+    }
+    bounds.push_back( file.size() );
+    return bounds;
+  }
+
+  /**
+   * Pass every key to visit as a std::string. One string is reused for
+   * every key, so visit must copy it to keep it.
+   * @param visit called as visit( key ) for each key
+   */
+  template< typename Visitor >
+  void for_each( Visitor visit ) const
+  {
+    for_each( 0, file.size(), visit );
+  }
+
+  /**
+   * Pass every key that starts in the byte range [begin, end) to visit
+   * @param begin the first byte of the range
+   * @param end one past the last byte of the range
+   * @param visit called as visit( key ) for each key
+   */
+  template< typename Visitor >
+  void for_each( size_t begin, size_t end, Visitor visit ) const
+  {
+    std::string key;
+    for_each_line( begin, end, [ &key, &visit ]( const char * line,
+                                                 size_t length )
+                   {
+                     key.assign( line, length );
+                     visit( key );
+                   } );
+  }
+
+  /**
+   * Pass each line that starts in [begin, end) to visit as a pointer
+   * and length; a line may run past end. begin must be the start of a
+   * line.
+   * @param begin the first byte of the range
+   * @param end one past the last byte of the range
+   * @param visit called as visit( line, length ) for each line
+   */
+  template< typename Visitor >
+  void for_each_line( size_t begin, size_t end, Visitor visit ) const
+  {
+    const char * data = file.data();
+    const char * limit = data + file.size();
+    const char * line = data + begin;
+    while( line < data + end )
+    {
+      const char * newline = static_cast< const char * >(
+        memchr( line, '\n', limit - line ) );
+      const char * stop = newline == nullptr ? limit : newline;
+      visit( line, size_t( stop - line ) );
+      line = stop + 1;
+    }
+  }
+
+ private:
+  /**
+   * The first line that starts at or after offset
+   */
+  size_t line_start( size_t offset ) const
+  {
+    if( offset == 0 || offset >= file.size() )
+      return std::min( offset, file.size() );
+    const char * data = file.data();
+    const void * newline = memchr( data + offset - 1, '\n',
+                                   file.size() - offset + 1 );
+    return newline == nullptr ? file.size()
+      : static_cast< const char * >( newline ) - data + 1;
+  }
+
+  MappedFile file;
+  size_t keys;
+  bool counted;
+};
+
+#endif
@@ -0,0 +1,165 @@
+/**
+ * benchmark of List's node allocators under push/pop churn
+ *
+ * runs two workloads on List with the default NodePool and with
+ * HeapNodes, one heap allocation per node as List used to do, for a
+ * small payload and a 64-byte one. queue keeps a window of elements,
+ * pushing one on the back and popping one off the front per operation,
+ * as a work queue does; burst pushes a whole window and clears it, over
+ * and over. it reports millions of operations per second and checks
+ * that both allocators popped the same values
+ *
+ * usage: list_bench [operations] [window]
+ *
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "node_pool.h"
+#include "singly_linked_list.h"
+
+using namespace std;
+
+/**
+ * A payload the size of a cache line
+ */
+struct Record
+{
+  uint64_t key;
+  uint64_t fields[ 7 ];
+
+  Record( uint64_t key = 0 ) : key{ key }, fields{} {}
+};
+
+/**
+ * The value a payload contributes to the checksum
+ */
+uint64_t value( uint64_t item )
+{
+  return item;
+}
+
+uint64_t value( const Record & item )
+{
+  return item.key;
+}
+
+/**
+ * Push on the back and pop off the front of a list holding window
+ * elements, operations times
+ * @return the sum of the values popped
+ */
+template< typename List >
+uint64_t queue( size_t operations, size_t window );
+
+/**
+ * Fill a list with window elements and clear it until operations
+ * elements have been pushed
+ * @return the sum of the values at the front before each clear
+ */
+template< typename List >
+uint64_t burst( size_t operations, size_t window );
+
+/**
+ * Time one workload and print one result line
+ * @return the workload's checksum
+ */
+template< typename Workload >
+uint64_t run( const string & workload, const string & payload,
+              const string & allocator, size_t operations, Workload body );
+
+int main( int argc, char * argv[] )
+{
+  size_t operations = argc > 1 ? strtoul( argv[ 1 ], nullptr, 10 )
+    : 20000000;
+  size_t window = argc > 2 ? strtoul( argv[ 2 ], nullptr, 10 ) : 1000;
+  if( window == 0 )
+    window = 1;
+
+  cout << "operations: " << operations << ", window: " << window << endl;
+  cout << left << setw( 10 ) << "workload" << setw( 10 ) << "payload"
+       << setw( 12 ) << "allocator" << setw( 12 ) << "seconds" << "Mops/s"
+       << endl;
+  bool valid = true;
+  auto compare = [ & ]( const string & workload, const string & payload,
+                        auto pooled, auto heap )
+    {
+      valid &= run( workload, payload, "NodePool", operations, pooled )
+        == run( workload, payload, "HeapNodes", operations, heap );
+    };
+  compare( "queue", "uint64",
+           [ & ] { return queue< List< uint64_t > >( operations, window ); },
+           [ & ] { return queue< List< uint64_t, HeapNodes > >( operations,
+                                                                window ); } );
+  compare( "queue", "64 bytes",
+           [ & ] { return queue< List< Record > >( operations, window ); },
+           [ & ] { return queue< List< Record, HeapNodes > >( operations,
+                                                              window ); } );
+  compare( "burst", "uint64",
+           [ & ] { return burst< List< uint64_t > >( operations, window ); },
+           [ & ] { return burst< List< uint64_t, HeapNodes > >( operations,
+                                                                window ); } );
+  compare( "burst", "64 bytes",
+           [ & ] { return burst< List< Record > >( operations, window ); },
+           [ & ] { return burst< List< Record, HeapNodes > >( operations,
+                                                              window ); } );
+  if( !valid )
+    cout << "the allocators disagree on the values popped" << endl;
+  return valid ? 0 : 1;
+}
+
+template< typename List >
+uint64_t queue( size_t operations, size_t window )
+{
+  List list;
+  for( size_t i = 0; i < window; i++ )
+  {
+    list.push_back( i );
+  }
+  uint64_t sum = 0;
+  for( size_t i = 0; i < operations; i++ )
+  {
+    sum += value( list.front() );
+    list.pop_front();
+    list.push_back( window + i );
+  }
+  return sum;
+}
+
+template< typename List >
+uint64_t burst( size_t operations, size_t window )
+{
+  List list;
+  uint64_t sum = 0;
+  for( size_t done = 0; done < operations; done += window )
+  {
+    for( size_t i = 0; i < window; i++ )
+    {
+      list.push_back( done + i );
+    }
+    sum += value( list.front() );
+    list.clear();
+  }
+  return sum;
+}
+
+template< typename Workload >
+uint64_t run( const string & workload, const string & payload,
+              const string & allocator, size_t operations, Workload body )
+{
+  auto start = chrono::steady_clock::now();
+  uint64_t checksum = body();
+  chrono::duration< double > elapsed = chrono::steady_clock::now() - start;
+
+  cout << left << setw( 10 ) << workload << setw( 10 ) << payload
+       << setw( 12 ) << allocator << setw( 12 ) << fixed << setprecision( 4 )
+       << elapsed.count() << setprecision( 1 )
+       << operations / elapsed.count() / 1e6 << endl;
+  return checksum;
+}
@@ -0,0 +1,381 @@
+#ifndef MONEY_LOCAL_SEARCH
+#define MONEY_LOCAL_SEARCH
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include <vector>
+#include "csr_graph.h"
+#include "edge_weights.h"
+
+/**
+ * Local search that shortens a Hamiltonian circuit with 2-opt and
+ * Or-opt moves, run on the twice-around circuit of hamiltonian_MST.cpp.
+ *
+ * The tour is an array of vertices plus each vertex's position in it,
+ * so the neighbours on either side are found in O(1) and a 2-opt move
+ * reverses a run of the array in place, always the shorter of the two
+ * runs that give the same cycle. An Or-opt move, which moves a segment
+ * of one to three vertices elsewhere, possibly reversed, is done as two
+ * or three 2-opt moves.
+ *
+ * Moves are only tried towards each vertex's k nearest neighbours,
+ * taken from its lightest edges in the graph and sorted by weight, and
+ * the scan of a list stops at the first neighbour too far away to
+ * give any gain. Every vertex carries a don't-look bit: vertices wait
+ * in a queue, a vertex that yields no move leaves it, and the ends of
+ * every edge a move changes rejoin it. The search ends when the queue
+ * is empty, which is a local optimum for these moves and lists, and
+ * each pass over the queue costs about O(V k) lookups plus the
+ * reversals.
+ *
+ * Weights come from an EdgeWeights lookup. A step that is not an edge
+ * costs EdgeWeights::ABSENT, so moves steer away from missing edges,
+ * and lengths count it as nothing, as TwiceAround's do. Circuits of
+ * fewer than eight vertices are left as they are.
+ *
+ * A basic operation is one candidate neighbour examined.
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+class LocalSearch
+{
+ public:
+  /**
+   * Construct an engine
+   * @param neighbors the length of each vertex's candidate list
+   * @param or_opt whether to try Or-opt moves as well as 2-opt
+   */
+  explicit LocalSearch( size_t neighbors = 8, bool or_opt = true )
+    : neighbors{ neighbors > 0 ? neighbors : 1 }, or_opt{ or_opt },
+      initial_length{ 0 }, length{ 0 }, moves{ 0 }, op_count{ 0 } {}
+
+  /**
+   * Improve a circuit until no move helps
+   * @param graph the graph, every edge in both directions
+   * @param weights the weight lookup of the graph
+   * @param circuit a circuit, its start repeated last; rewritten from
+   *        the same start
+   * @return the number of basic operations
+   */
+  size_t compute( const CSRGraph & graph, EdgeWeights & weights,
+                  std::vector< uint > & circuit )
+  {
+    lookup = &weights;
+    moves = 0;
+    op_count = 0;
+    initial_length = 0;
+    length = 0;
+    // no circuit, or a single vertex: there is nothing to move
+    if( circuit.size() < 2 )
+      return op_count;
+
+    size_t n = circuit.size() - 1;
+    order.assign( circuit.begin(), circuit.begin() + n );
+    position.assign( graph.size(), 0 );
+    for( size_t i = 0; i < n; i++ )
+    {
+      position[ order[ i ] ] = i;
+    }
+    initial_length = tour_length();
+
+    if( n >= MIN_SIZE )
+    {
+      build_candidates( graph );
+      queued.assign( graph.size(), true );
+      queue.assign( order.begin(), order.end() );
+      while( !queue.empty() )
+      {
+        uint vertex = queue.front();
+        queue.pop_front();
+        queued[ vertex ] = false;
+        if( two_opt_from( vertex ) || ( or_opt && or_opt_from( vertex ) ) )
+          wake( vertex );
+      }
+      candidates = std::vector< uint >();
+      queue = std::deque< uint >();
+    }
+
+    length = tour_length();
+    uint start = circuit.front();
+    for( size_t i = 0; i < n; i++ )
+    {
+      circuit[ i ] = order[ ( position[ start ] + i ) % n ];
+    }
+    return op_count;
+  }
+
+  /**
+   * Accessor for the length of the circuit before the last search
+   * @return the sum of the weights of its steps
+   */
+  uint64_t get_initial_length() const
+  {
+    return initial_length;
+  }
+
+  /**
+   * Accessor for the length of the circuit after the last search
+   * @return the sum of the weights of its steps
+   */
+  uint64_t get_length() const
+  {
+    return length;
+  }
+
+  /**
+   * Accessor for the number of improving moves the last search made
+   * @return the move count
+   */
+  size_t get_moves() const
+  {
+    return moves;
+  }
+
+  /**
+   * Accessor for the basic operations of the last computation
+   * @return the count of basic operations
+   */
+  size_t get_op_count() const
+  {
+    return op_count;
+  }
+
+ private:
+  static constexpr size_t MIN_SIZE = 8;
+  static constexpr size_t SEGMENT = 3;
+
+  size_t neighbors;
+  bool or_opt;
+  uint64_t initial_length;
+  uint64_t length;
+  size_t moves;
+  size_t op_count;
+  EdgeWeights * lookup;
+  std::vector< uint > order;      // the tour
+  std::vector< size_t > position; // of each vertex in order
+  std::vector< uint > candidates; // neighbors per vertex, nearest first
+  std::vector< uint > candidate_count;
+  std::vector< bool > queued;     // the inverse of the don't-look bit
+  std::deque< uint > queue;
+
+  /**
+   * The weight of a step, ABSENT for a missing edge
+   */
+  int64_t cost( uint from, uint to )
+  {
+    return lookup->get( from, to );
+  }
+
+  /**
+   * The length of the tour in order, missing edges counting nothing
+   */
+  uint64_t tour_length()
+  {
+    uint64_t total = 0;
+    for( size_t i = 0; i < order.size() && order.size() > 1; i++ )
+    {
+      uint weight = lookup->get( order[ i ],
+                                 order[ ( i + 1 ) % order.size() ] );
+      if( weight != EdgeWeights::ABSENT )
+        total += weight;
+    }
+    return total;
+  }
+
+  /**
+   * Fill each vertex's candidate list with the targets of its lightest
+   * edges, lightest first
+   */
+  void build_candidates( const CSRGraph & graph )
+  {
+    candidates.assign( graph.size() * neighbors, 0 );
+    candidate_count.assign( graph.size(), 0 );
+    std::vector< std::pair< uint, uint > > edges;
+    for( size_t v = 0; v < graph.size(); v++ )
+    {
+      edges.clear();
+      for( size_t e = graph.begin( v ); e < graph.begin( v + 1 ); e++ )
+      {
+        if( graph.target( e ) != v )
+          edges.push_back( { graph.weight( e ), graph.target( e ) } );
+      }
+      size_t count = std::min( neighbors, edges.size() );
+      std::partial_sort( edges.begin(), edges.begin() + count, edges.end() );
+      for( size_t i = 0; i < count; i++ )
+      {
+        candidates[ v * neighbors + i ] = edges[ i ].second;
+      }
+      candidate_count[ v ] = count;
+    }
+  }
+
+  /**
+   * The vertex after another, forward or backward along the tour
+   */
+  uint step( uint vertex, bool forward ) const
+  {
+    size_t n = order.size();
+    size_t at = position[ vertex ];
+    return order[ forward ? ( at + 1 == n ? 0 : at + 1 )
+                  : ( at == 0 ? n - 1 : at - 1 ) ];
+  }
+
+  /**
+   * Reverse the run of the tour from position from forward to position
+   * to, or the rest of the tour instead if that is shorter
+   */
+  void reverse( size_t from, size_t to )
+  {
+    size_t n = order.size();
+    size_t inner = ( to + n - from ) % n + 1;
+    if( 2 * inner > n )
+    {
+      size_t after = to + 1 == n ? 0 : to + 1;
+      to = from == 0 ? n - 1 : from - 1;
+      from = after;
+      inner = n - inner;
+    }
+    for( size_t i = 0; i < inner / 2; i++ )
+    {
+      uint first = order[ from ];
+      uint second = order[ to ];
+      order[ from ] = second;
+      position[ second ] = from;
+      order[ to ] = first;
+      position[ first ] = to;
+      from = from + 1 == n ? 0 : from + 1;
+      to = to == 0 ? n - 1 : to - 1;
+    }
+  }
+
+  /**
+   * Replace the tour edges ( a, b ) and ( c, d ) with ( a, c ) and
+   * ( b, d ), where b follows a and d follows c in the same direction,
+   * by reversing the path from b to c
+   */
+  void two_opt_move( uint a, uint b, uint c )
+  {
+    if( step( a, true ) == b )
+      reverse( position[ b ], position[ c ] );
+    else
+      reverse( position[ c ], position[ b ] );
+  }
+
+  /**
+   * Put a vertex back in the queue, clearing its don't-look bit
+   */
+  void wake( uint vertex )
+  {
+    if( !queued[ vertex ] )
+    {
+      queued[ vertex ] = true;
+      queue.push_back( vertex );
+    }
+  }
+
+  /**
+   * Try the 2-opt moves that join a vertex to one of its candidates
+   * @return true if a move was made
+   */
+  bool two_opt_from( uint a )
+  {
+    for( int forward = 0; forward < 2; forward++ )
+    {
+      uint b = step( a, forward );
+      int64_t ab = cost( a, b );
+      for( size_t i = 0; i < candidate_count[ a ]; i++ )
+      {
+        op_count++;
+        uint c = candidates[ a * neighbors + i ];
+        int64_t gain = ab - cost( a, c );
+        if( gain <= 0 )
+          break;
+        uint d = step( c, forward );
+        if( c == b || d == a )
+          continue;
+        if( gain + cost( c, d ) - cost( b, d ) > 0 )
+        {
+          two_opt_move( a, b, c );
+          moves++;
+          wake( b );
+          wake( c );
+          wake( d );
+          return true;
+        }
+      }
+    }
+    return false;
+  }
+
+  /**
+   * Try moving a segment of one to three vertices that starts at a
+   * next to one of a's candidates
+   * @return true if a move was made
+   */
+  bool or_opt_from( uint a )
+  {
+    uint segment[ SEGMENT ];
+    for( int forward = 0; forward < 2; forward++ )
+    {
+      uint before = step( a, !forward );
+      uint last = a;
+      for( size_t k = 1; k <= SEGMENT; k++ )
+      {
+        if( k > 1 )
+          last = step( last, forward );
+        segment[ k - 1 ] = last;
+        uint after = step( last, forward );
+        if( after == before )
+          break;
+        int64_t removed = cost( before, a ) + cost( last, after )
+          - cost( before, after );
+        if( removed <= 0 )
+          continue;
+
+        for( size_t i = 0; i < candidate_count[ a ]; i++ )
+        {
+          op_count++;
+          uint c = candidates[ a * neighbors + i ];
+          if( cost( a, c ) >= removed )
+            break;
+          if( std::find( segment, segment + k, c ) != segment + k )
+            continue;
+          // a lands next to c: straight after c, or reversed before it
+          for( int straight = 0; straight < 2; straight++ )
+          {
+            uint x = straight ? c : step( c, !forward );
+            uint y = straight ? step( c, forward ) : c;
+            if( y == before
+                || std::find( segment, segment + k, x ) != segment + k
+                || std::find( segment, segment + k, y ) != segment + k )
+              continue;
+            int64_t added = ( straight ? cost( x, a ) + cost( last, y )
+                              : cost( x, last ) + cost( a, y ) )
+              - cost( x, y );
+            if( removed - added > 0 )
+            {
+              // x ... before a..last after ... y becomes x last..a y
+              two_opt_move( before, a, x );
+              two_opt_move( before, x, after );
+              if( straight && k > 1 )
+                two_opt_move( x, last, a );
+              moves++;
+              wake( before );
+              wake( after );
+              wake( last );
+              wake( x );
+              wake( y );
+              return true;
+            }
+          }
+        }
+      }
+    }
+    return false;
+  }
+};
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef MONEY_MAPPED_FILE
+#define MONEY_MAPPED_FILE
+
+#include <cstddef>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * A read-only memory mapping of a whole file, unmapped on destruction.
+ * Shared by the point loaders, the hash key readers and the perfect
+ * hash tables.
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+class MappedFile
+{
+ public:
+  /**
+   * Map the named file; check is_open before using the contents
+   * @param path the file to map
+   * @param sequential true to advise the kernel to read ahead, false
+   *        for contents that are read at random
+   */
+  explicit MappedFile( const std::string & path, bool sequential = true )
+    : bytes{ nullptr }, length{ 0 }, open{ false }
+  {
+    int descriptor = ::open( path.c_str(), O_RDONLY );
+    if( descriptor < 0 )
+      return;
+
+    struct stat info;
+    if( fstat( descriptor, &info ) == 0 )
+    {
+      length = info.st_size;
+      if( length == 0 )
+      {
+        open = true;
+      }
+      else
+      {
+        void * mapping = mmap( nullptr, length, PROT_READ, MAP_PRIVATE,
+                               descriptor, 0 );
+        if( mapping != MAP_FAILED )
+        {
+          madvise( mapping, length,
+                   sequential ? MADV_SEQUENTIAL : MADV_RANDOM );
+          bytes = static_cast< const char * >( mapping );
+          open = true;
+        }
+      }
+    }
+    close( descriptor );
+  }
+
+  MappedFile( const MappedFile & ) = delete;
+  MappedFile & operator=( const MappedFile & ) = delete;
+
+  /**
+   * The destructor unmaps the file
+   */
+  ~MappedFile()
+  {
+    if( bytes != nullptr )
+      munmap( const_cast< char * >( bytes ), length );
+  }
+
+  /**
+   * Accessor to determine whether the file was mapped
+   * @return true if the contents are available
+   */
+  bool is_open() const
+  {
+    return open;
+  }
+
+  /**
+   * Accessor for the first byte of the file
+   * @return the mapped contents
+   */
+  const char * data() const
+  {
+    return bytes;
+  }
+
+  /**
+   * Accessor for the length of the file
+   * @return the size in bytes
+   */
+  size_t size() const
+  {
+    return length;
+  }
+
+ private:
+  const char * bytes;
+  size_t length;
+  bool open;
+};
+
+#endif
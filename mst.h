@@ -0,0 +1,516 @@
+#ifndef MONEY_MST
+#define MONEY_MST
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "csr_graph.h"
+#include "edge.h"
+#include "priority_queue.h"
+#include "union_find.h"
+
+/**
+ * Minimum spanning tree engine for the twice-around algorithm in
+ * hamiltonian_MST.cpp. The graph and the tree are CSRGraphs; the tree
+ * holds every tree edge in both directions, and each vertex's edges
+ * are in the order they joined the tree, as the adjacency lists the
+ * program used to build were.
+ *
+ * PRIM_SCAN is the original loop, which rescans every remaining edge
+ * for each vertex added, O(V E). PRIM keeps the vertices outside the
+ * tree in an IndexedPQ keyed by their cheapest edge into it and lowers
+ * the key as edges are relaxed, O(E log V). Both add the cheapest
+ * crossing edge at every step, so with distinct weights they build the
+ * same tree edge for edge; with ties the tree may differ but its weight
+ * does not.
+ *
+ * KRUSKAL takes each undirected edge once, sorts them by weight with
+ * an LSD radix sort (11-bit digits, only as many passes as the largest
+ * weight needs; each pass counts and scatters one chunk of edges per
+ * thread, so it is stable and parallel), then keeps every edge that
+ * joins two components of a UnionFind. Its tree is then re-walked with
+ * PRIM, which takes O(V log V) on a tree, so every backend hands the
+ * twice-around step the same tree in the same order.
+ *
+ * BORUVKA works in rounds over the same list of undirected edges, each
+ * round in three parallel phases over chunks of it: every edge between
+ * two components offers itself to both with an atomic minimum, so each
+ * component ends up holding its cheapest outgoing edge; every component
+ * then joins along its edge through a ConcurrentUnionFind, where only
+ * the thread whose unite succeeds records the edge; finally the edges
+ * now inside one component are compacted away. Edges are ordered by
+ * weight, then by position in the list, a strict order, so the chosen
+ * edges never close a cycle longer than one edge picked from both
+ * sides. Components at least halve every round, so there are at most
+ * log V rounds; the list holds up to 2^32 - 1 edges. Its tree is put in
+ * PRIM order as KRUSKAL's is.
+ *
+ * A basic operation is one edge examined, one heap level moved, one
+ * union-find link followed or one edge moved by a sort pass. A graph
+ * that is not connected gets a spanning forest, one tree per
+ * component, each grown from its lowest vertex.
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+class MST
+{
+ public:
+  enum class Algorithm { PRIM_SCAN, PRIM, KRUSKAL, BORUVKA };
+
+  /**
+   * Construct an engine
+   * @param algorithm the algorithm compute runs
+   * @param threads the number of threads compute may use
+   */
+  explicit MST( Algorithm algorithm = Algorithm::PRIM, unsigned threads = 1 )
+    : algorithm{ algorithm }, threads{ threads > 0 ? threads : 1 },
+      weight{ 0 }, op_count{ 0 } {}
+
+  /**
+   * Compute a minimum spanning tree
+   * @param graph the graph, every edge in both directions
+   * @param mst set to the tree, every edge in both directions
+   * @return the number of basic operations
+   */
+  size_t compute( const CSRGraph & graph, CSRGraph & mst )
+  {
+    tree_edges.clear();
+    weight = 0;
+    op_count = 0;
+    if( algorithm == Algorithm::PRIM_SCAN )
+    {
+      prim_scan( graph );
+    }
+    else if( algorithm == Algorithm::PRIM )
+    {
+      prim( graph );
+    }
+    else
+    {
+      if( algorithm == Algorithm::KRUSKAL )
+        kruskal( graph );
+      else
+        boruvka( graph );
+      prim_order( graph.size() );
+    }
+    mst = CSRGraph( graph.size(), tree_edges );
+    tree_edges = std::vector< Edge >();
+    return op_count;
+  }
+
+  /**
+   * Accessor for the weight of the last tree computed
+   * @return the sum of the tree edge weights
+   */
+  uint64_t get_weight() const
+  {
+    return weight;
+  }
+
+  /**
+   * Accessor for the basic operations of the last computation
+   * @return the count of basic operations
+   */
+  size_t get_op_count() const
+  {
+    return op_count;
+  }
+
+ private:
+  static constexpr int RADIX_BITS = 11;
+  static constexpr size_t RADIX = size_t( 1 ) << RADIX_BITS;
+
+  /**
+   * An undirected edge for Kruskal's sort, weight first
+   */
+  struct WeightedEdge
+  {
+    uint weight;
+    uint from;
+    uint to;
+  };
+
+  Algorithm algorithm;
+  unsigned threads;
+  uint64_t weight;
+  size_t op_count;
+  std::vector< Edge > tree_edges; // both directions, in joining order
+
+  /**
+   * Append an edge and its reverse to the tree
+   */
+  void add_edge( const Edge & edge )
+  {
+    Edge other_direction;
+    other_direction.start_vertex = edge.end_vertex;
+    other_direction.end_vertex = edge.start_vertex;
+    other_direction.weight = edge.weight;
+
+    tree_edges.push_back( edge );
+    tree_edges.push_back( other_direction );
+    weight += edge.weight;
+  }
+
+  /**
+   * The original Prim loop: find the cheapest edge from a known to an
+   * unknown vertex by scanning every edge, then drop the edges between
+   * known vertices
+   */
+  void prim_scan( const CSRGraph & graph )
+  {
+    size_t vertices = graph.size();
+    std::vector< Edge > all_edges;
+    for( size_t v = 0; v < vertices; v++ )
+    {
+      all_edges.insert( all_edges.end(), graph.edges( v ).begin(),
+                        graph.edges( v ).end() );
+    }
+    std::vector< bool > known( vertices, false );
+    for( size_t root = 0; root < vertices; root++ )
+    {
+      if( known.at( root ) )
+        continue;
+      known.at( root ) = true;
+
+      while( true )
+      {
+        // get shortest-distance edge from known to unknown vertices
+        const Edge * shortest_edge = nullptr;
+        for( auto & edge : all_edges )
+        {
+          op_count++;
+          if( known.at( edge.start_vertex )
+              && !known.at( edge.end_vertex )
+              && ( shortest_edge == nullptr || edge < *shortest_edge ) )
+          {
+            shortest_edge = &edge;
+          }
+        }
+        if( shortest_edge == nullptr )
+          break;
+
+        known.at( shortest_edge->end_vertex ) = true;
+        add_edge( *shortest_edge );
+
+        // go through and remove all edges from a known to a known vertex
+        // this is not essential but results in fewer basic operations
+        std::vector< Edge > edges_to_keep;
+        for( auto & edge : all_edges )
+        {
+          if( !known.at( edge.start_vertex ) || !known.at( edge.end_vertex ) )
+          {
+            edges_to_keep.push_back( edge );
+          }
+        }
+        all_edges.swap( edges_to_keep );
+      }
+    }
+  }
+
+  /**
+   * Prim's algorithm with an indexed heap: pop the unknown vertex with
+   * the cheapest edge into the tree, add that edge, and offer every
+   * edge out of the vertex to its unknown neighbours
+   */
+  void prim( const CSRGraph & graph )
+  {
+    std::vector< bool > known( graph.size(), false );
+    std::vector< Edge > cheapest( graph.size() );
+    IndexedPQ queue( graph.size() );
+
+    for( size_t root = 0; root < graph.size(); root++ )
+    {
+      if( known.at( root ) )
+        continue;
+      queue.insert( root, 0 );
+      while( !queue.is_empty() )
+      {
+        uint vertex = queue.remove();
+        known[ vertex ] = true;
+        if( vertex != root )
+          add_edge( cheapest[ vertex ] );
+
+        for( size_t e = graph.begin( vertex ); e < graph.begin( vertex + 1 );
+             e++ )
+        {
+          op_count++;
+          uint next = graph.target( e );
+          if( !known[ next ] &&
+              queue.insert_or_decrease( next, graph.weight( e ) ) )
+          {
+            cheapest[ next ].start_vertex = vertex;
+            cheapest[ next ].end_vertex = next;
+            cheapest[ next ].weight = graph.weight( e );
+          }
+        }
+      }
+    }
+    op_count += queue.get_op_count();
+  }
+
+  /**
+   * Replace the tree edges, found in any order, with the same tree in
+   * the order prim adds its edges
+   */
+  void prim_order( size_t vertices )
+  {
+    CSRGraph forest( vertices, tree_edges );
+    tree_edges.clear();
+    weight = 0;
+    prim( forest );
+  }
+
+  /**
+   * Kruskal's algorithm: sort the edges by weight, then keep each edge
+   * whose ends are still in different components
+   */
+  void kruskal( const CSRGraph & graph )
+  {
+    std::vector< WeightedEdge > edges = undirected_edges( graph );
+    radix_sort( edges );
+
+    UnionFind components( graph.size() );
+    for( auto & edge : edges )
+    {
+      op_count++;
+      if( components.unite( edge.from, edge.to ) )
+      {
+        Edge joined;
+        joined.start_vertex = edge.from;
+        joined.end_vertex = edge.to;
+        joined.weight = edge.weight;
+        add_edge( joined );
+        if( components.set_count() == 1 )
+          break;
+      }
+    }
+    op_count += components.get_op_count();
+  }
+
+  /**
+   * Every edge of the graph once, from its smaller end
+   */
+  static std::vector< WeightedEdge > undirected_edges( const CSRGraph & graph )
+  {
+    std::vector< WeightedEdge > edges;
+    edges.reserve( graph.edge_count() / 2 );
+    for( size_t v = 0; v < graph.size(); v++ )
+    {
+      for( size_t e = graph.begin( v ); e < graph.begin( v + 1 ); e++ )
+      {
+        if( v < graph.target( e ) )
+          edges.push_back( { graph.weight( e ), uint( v ),
+                             graph.target( e ) } );
+      }
+    }
+    return edges;
+  }
+
+  /**
+   * Borůvka's algorithm, each round's phases spread over the threads
+   */
+  void boruvka( const CSRGraph & graph )
+  {
+    const uint64_t NONE = UINT64_MAX;
+    size_t n = graph.size();
+    std::vector< WeightedEdge > edges = undirected_edges( graph );
+    assert( edges.size() < ( uint64_t( 1 ) << 32 ) );
+    std::vector< WeightedEdge > buffer( edges.size() );
+    ConcurrentUnionFind components( n );
+    std::unique_ptr< std::atomic< uint64_t >[] > cheapest(
+      new std::atomic< uint64_t >[ n ] );
+    for( size_t v = 0; v < n; v++ )
+    {
+      cheapest[ v ].store( NONE, std::memory_order_relaxed );
+    }
+    std::vector< std::vector< Edge > > joined( threads );
+    std::vector< size_t > kept( threads + 1 );
+    std::vector< size_t > ops( threads, 0 );
+
+    while( !edges.empty() )
+    {
+      size_t m = edges.size();
+      size_t chunk = ( m + threads - 1 ) / threads;
+      size_t vertex_chunk = ( n + threads - 1 ) / threads;
+
+      // each component's cheapest outgoing edge, as weight and index
+      parallel( [ & ]( unsigned t )
+                {
+                  size_t end = std::min( m, ( t + 1 ) * chunk );
+                  for( size_t i = std::min( m, t * chunk ); i < end; i++ )
+                  {
+                    ops[ t ]++;
+                    uint from = components.find( edges[ i ].from );
+                    uint to = components.find( edges[ i ].to );
+                    if( from == to )
+                      continue;
+                    uint64_t key = ( uint64_t( edges[ i ].weight ) << 32 ) | i;
+                    offer( cheapest[ from ], key );
+                    offer( cheapest[ to ], key );
+                  }
+                } );
+
+      // join every component along its edge
+      parallel( [ & ]( unsigned t )
+                {
+                  size_t end = std::min( n, ( t + 1 ) * vertex_chunk );
+                  for( size_t v = std::min( n, t * vertex_chunk ); v < end;
+                       v++ )
+                  {
+                    uint64_t key = cheapest[ v ].load(
+                      std::memory_order_relaxed );
+                    if( key == NONE )
+                      continue;
+                    cheapest[ v ].store( NONE, std::memory_order_relaxed );
+                    const WeightedEdge & edge = edges[ key & UINT32_MAX ];
+                    ops[ t ]++;
+                    if( components.unite( edge.from, edge.to ) )
+                    {
+                      Edge tree_edge;
+                      tree_edge.start_vertex = edge.from;
+                      tree_edge.end_vertex = edge.to;
+                      tree_edge.weight = edge.weight;
+                      joined[ t ].push_back( tree_edge );
+                    }
+                  }
+                } );
+
+      // drop the edges now inside a component, keeping the order
+      parallel( [ & ]( unsigned t )
+                {
+                  size_t count = 0;
+                  size_t end = std::min( m, ( t + 1 ) * chunk );
+                  for( size_t i = std::min( m, t * chunk ); i < end; i++ )
+                  {
+                    if( components.find( edges[ i ].from )
+                        != components.find( edges[ i ].to ) )
+                      edges[ t * chunk + count++ ] = edges[ i ];
+                  }
+                  kept[ t + 1 ] = count;
+                } );
+      for( unsigned t = 0; t < threads; t++ )
+      {
+        kept[ t + 1 ] += kept[ t ];
+      }
+      parallel( [ & ]( unsigned t )
+                {
+                  std::copy( edges.begin() + std::min( m, t * chunk ),
+                             edges.begin() + std::min( m, t * chunk )
+                               + ( kept[ t + 1 ] - kept[ t ] ),
+                             buffer.begin() + kept[ t ] );
+                } );
+      buffer.resize( kept[ threads ] );
+      edges.swap( buffer );
+      buffer.resize( edges.size() );
+    }
+
+    for( unsigned t = 0; t < threads; t++ )
+    {
+      op_count += ops[ t ];
+      for( auto & edge : joined[ t ] )
+      {
+        add_edge( edge );
+      }
+    }
+  }
+
+  /**
+   * Lower an atomic key to key if key is smaller; the plain load first
+   * keeps threads off the cache line once a cheap edge is in place
+   */
+  static void offer( std::atomic< uint64_t > & slot, uint64_t key )
+  {
+    uint64_t current = slot.load( std::memory_order_relaxed );
+    while( key < current &&
+           !slot.compare_exchange_weak( current, key,
+                                        std::memory_order_relaxed ) ) {}
+  }
+
+  /**
+   * Stable LSD radix sort of edges by weight. Each pass, every thread
+   * counts the digits of its own chunk, the counts are turned into
+   * per-thread output offsets in digit-then-chunk order, and every
+   * thread scatters its chunk
+   */
+  void radix_sort( std::vector< WeightedEdge > & edges )
+  {
+    uint largest = 0;
+    for( auto & edge : edges )
+    {
+      largest = std::max( largest, edge.weight );
+    }
+    size_t n = edges.size();
+    size_t chunk = ( n + threads - 1 ) / threads;
+    std::vector< WeightedEdge > buffer( n );
+    std::vector< size_t > offsets( threads * RADIX );
+
+    for( int shift = 0; shift < 32 && ( largest >> shift ) > 0;
+         shift += RADIX_BITS )
+    {
+      op_count += n;
+      std::fill( offsets.begin(), offsets.end(), 0 );
+      parallel( [ & ]( unsigned t )
+                {
+                  size_t * counts = &offsets[ t * RADIX ];
+                  size_t end = std::min( n, ( t + 1 ) * chunk );
+                  for( size_t i = std::min( n, t * chunk ); i < end; i++ )
+                  {
+                    counts[ ( edges[ i ].weight >> shift ) & ( RADIX - 1 ) ]++;
+                  }
+                } );
+      size_t total = 0;
+      for( size_t digit = 0; digit < RADIX; digit++ )
+      {
+        for( unsigned t = 0; t < threads; t++ )
+        {
+          size_t count = offsets[ t * RADIX + digit ];
+          offsets[ t * RADIX + digit ] = total;
+          total += count;
+        }
+      }
+      parallel( [ & ]( unsigned t )
+                {
+                  size_t * next = &offsets[ t * RADIX ];
+                  size_t end = std::min( n, ( t + 1 ) * chunk );
+                  for( size_t i = std::min( n, t * chunk ); i < end; i++ )
+                  {
+                    buffer[ next[ ( edges[ i ].weight >> shift )
+                                  & ( RADIX - 1 ) ]++ ] = edges[ i ];
+                  }
+                } );
+      edges.swap( buffer );
+    }
+  }
+
+  /**
+   * Run body( t ) for every thread index t, on the calling thread when
+   * there is only one
+   */
+  template< typename Body >
+  void parallel( Body body )
+  {
+    if( threads == 1 )
+    {
+      body( 0 );
+      return;
+    }
+    std::vector< std::thread > pool;
+    for( unsigned t = 0; t < threads; t++ )
+    {
+      pool.emplace_back( body, t );
+    }
+    for( auto & worker : pool )
+    {
+      worker.join();
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,174 @@
+/**
+ * benchmark of the MST engine backends on random graphs
+ *
+ * builds a random sparse graph (average degree 8, like a road network)
+ * and a random dense graph (every pair of a smaller vertex set joined
+ * with probability 1/2), both connected, with random weights, and times
+ * prim, kruskal and boruvka on each, kruskal and boruvka on one thread
+ * and on the given number. every backend must find a tree of the same
+ * weight
+ *
+ * usage: mst_bench [sparse vertices] [seed] [threads]
+ * the dense graph has sqrt( 16 * sparse vertices ) vertices so both
+ * have about the same number of edges; threads defaults to all
+ * hardware threads
+ *
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "csr_graph.h"
+#include "edge.h"
+#include "mst.h"
+
+using namespace std;
+
+/**
+ * Build a connected random graph: a random spanning tree plus edges
+ * between random pairs, each stored in both directions
+ * @param vertices the number of vertices
+ * @param edges the number of undirected edges, at least vertices - 1
+ * @param generator the random source
+ * @return the graph
+ */
+CSRGraph random_graph( size_t vertices, size_t edges, mt19937_64 & generator );
+
+/**
+ * Build a connected random graph where each pair of vertices is joined
+ * with probability 1/2
+ * @param vertices the number of vertices
+ * @param generator the random source
+ * @return the graph
+ */
+CSRGraph dense_graph( size_t vertices, mt19937_64 & generator );
+
+/**
+ * Run and time one backend and print one result line
+ * @param label the name of the graph
+ * @param name the name of the backend
+ * @param algorithm the backend
+ * @param threads the number of threads it may use
+ * @param graph the graph
+ * @return the weight of the tree found
+ */
+uint64_t run( const string & label, const string & name,
+              MST::Algorithm algorithm, unsigned threads,
+              const CSRGraph & graph );
+
+int main( int argc, char * argv[] )
+{
+  size_t vertices = argc > 1 ? strtoul( argv[ 1 ], nullptr, 10 ) : 1000000;
+  unsigned seed = argc > 2 ? strtoul( argv[ 2 ], nullptr, 10 ) : 320;
+  unsigned threads = argc > 3 ? strtoul( argv[ 3 ], nullptr, 10 )
+    : max( 1u, thread::hardware_concurrency() );
+  string suffix = "/" + to_string( threads );
+  mt19937_64 generator( seed );
+
+  vector< CSRGraph > graphs;
+  graphs.push_back( random_graph( vertices, 4 * vertices, generator ) );
+  graphs.push_back( dense_graph( size_t( sqrt( 16.0 * vertices ) ),
+                                 generator ) );
+  const char * labels[] = { "sparse", "dense" };
+
+  cout << left << setw( 8 ) << "graph" << setw( 10 ) << "vertices"
+       << setw( 12 ) << "edges" << setw( 12 ) << "backend" << setw( 12 )
+       << "seconds" << setw( 14 ) << "basic ops" << "weight" << endl;
+  bool valid = true;
+  for( size_t g = 0; g < graphs.size(); g++ )
+  {
+    uint64_t prim = run( labels[ g ], "prim", MST::Algorithm::PRIM, 1,
+                         graphs[ g ] );
+    valid &= run( labels[ g ], "kruskal", MST::Algorithm::KRUSKAL, 1,
+                  graphs[ g ] ) == prim;
+    valid &= run( labels[ g ], "kruskal" + suffix, MST::Algorithm::KRUSKAL,
+                  threads, graphs[ g ] ) == prim;
+    valid &= run( labels[ g ], "boruvka", MST::Algorithm::BORUVKA, 1,
+                  graphs[ g ] ) == prim;
+    valid &= run( labels[ g ], "boruvka" + suffix, MST::Algorithm::BORUVKA,
+                  threads, graphs[ g ] ) == prim;
+  }
+  if( !valid )
+    cout << "backends disagree on the tree weight" << endl;
+  return valid ? 0 : 1;
+}
+
+CSRGraph random_graph( size_t vertices, size_t edges, mt19937_64 & generator )
+{
+  uniform_int_distribution< uint > weight( 1, 1000000 );
+  vector< Edge > both_ways;
+  auto join = [ & ]( uint from, uint to )
+  {
+    Edge edge;
+    edge.start_vertex = from;
+    edge.end_vertex = to;
+    edge.weight = weight( generator );
+    both_ways.push_back( edge );
+    swap( edge.start_vertex, edge.end_vertex );
+    both_ways.push_back( edge );
+  };
+
+  for( size_t v = 1; v < vertices; v++ )
+  {
+    join( uniform_int_distribution< size_t >( 0, v - 1 )( generator ), v );
+  }
+  uniform_int_distribution< size_t > vertex( 0, vertices - 1 );
+  for( size_t e = vertices - 1; e < edges; e++ )
+  {
+    uint from = vertex( generator );
+    uint to = vertex( generator );
+    if( from != to )
+      join( from, to );
+  }
+  return CSRGraph( vertices, both_ways );
+}
+
+CSRGraph dense_graph( size_t vertices, mt19937_64 & generator )
+{
+  uniform_int_distribution< uint > weight( 1, 1000000 );
+  vector< Edge > both_ways;
+  for( size_t from = 0; from < vertices; from++ )
+  {
+    for( size_t to = from + 1; to < vertices; to++ )
+    {
+      // the path 0, 1, 2, ... keeps the graph connected
+      if( to != from + 1 && generator() % 2 == 0 )
+        continue;
+      Edge edge;
+      edge.start_vertex = from;
+      edge.end_vertex = to;
+      edge.weight = weight( generator );
+      both_ways.push_back( edge );
+      swap( edge.start_vertex, edge.end_vertex );
+      both_ways.push_back( edge );
+    }
+  }
+  return CSRGraph( vertices, both_ways );
+}
+
+uint64_t run( const string & label, const string & name,
+              MST::Algorithm algorithm, unsigned threads,
+              const CSRGraph & graph )
+{
+  MST engine( algorithm, threads );
+  CSRGraph mst;
+  auto start = chrono::steady_clock::now();
+  engine.compute( graph, mst );
+  chrono::duration< double > elapsed = chrono::steady_clock::now() - start;
+
+  cout << left << setw( 8 ) << label << setw( 10 ) << graph.size()
+       << setw( 12 ) << graph.edge_count() / 2 << setw( 12 ) << name
+       << setw( 12 ) << fixed << setprecision( 4 ) << elapsed.count()
+       << setw( 14 ) << engine.get_op_count() << engine.get_weight() << endl;
+  return engine.get_weight();
+}
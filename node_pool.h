@@ -0,0 +1,260 @@
+#ifndef MONEY_NODE_POOL
+#define MONEY_NODE_POOL
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+/**
+ * Node allocators for the linked structures, List in particular. Each
+ * hands out raw storage for one T at a time; the caller constructs the
+ * T in it with placement new and destroys it before handing it back.
+ *
+ * NodePool carves nodes out of chunks of contiguous slots, the first
+ * FIRST_CHUNK slots long and each one after twice the one before, up
+ * to MAX_CHUNK. A slot handed back goes on a free list, threaded
+ * through the slots themselves, and is the next one handed out, so a
+ * structure that grows and shrinks reuses the same few chunks and
+ * never calls the heap allocator in steady state. release_all hands
+ * back every slot at once in O(1), keeping the chunks for reuse, and
+ * the chunks themselves are freed when the pool is. Moving a pool moves
+ * its chunks, so the nodes it handed out stay where they are.
+ *
+ * Nodes can move between structures, as List's splice moves them, so
+ * the chunks sit in a shared arena: a pool that is handed another
+ * pool's nodes calls share, and keeps the other's arena alive for as
+ * long as it may hold them. Either pool may hand such a node back to
+ * its own free list. A pool whose arena another one shares cannot know
+ * which of its slots are still in use, so release_all refuses and the
+ * structure hands its nodes back one at a time instead; a pool lets go
+ * of the arenas it shares when its own release_all succeeds. A pool
+ * belongs to one structure and is no more thread safe than it is;
+ * sharing an arena only shares its lifetime.
+ *
+ * HeapNodes is the plain heap allocation of one node at a time, with
+ * no bulk release, for comparison.
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+template< typename T >
+class NodePool
+{
+ public:
+  static constexpr size_t FIRST_CHUNK = 32;
+  static constexpr size_t MAX_CHUNK = 4096;
+
+  /**
+   * Construct an empty pool; no chunk is allocated until the first node
+   */
+  NodePool() : free_list{ nullptr }, current{ 0 }, used{ 0 } {}
+
+  NodePool( const NodePool & ) = delete;
+  NodePool & operator=( const NodePool & ) = delete;
+
+  /**
+   * Take over another pool's chunks, and with them every node it handed
+   * out, leaving it empty
+   */
+  NodePool( NodePool && other )
+    : free_list{ other.free_list }, arena( std::move( other.arena ) ),
+      shared( std::move( other.shared ) ), current{ other.current },
+      used{ other.used }
+  {
+    other.forget();
+  }
+
+  /**
+   * Let go of this pool's chunks and take over another's, leaving it
+   * empty
+   */
+  NodePool & operator=( NodePool && other )
+  {
+    if( this != &other )
+    {
+      free_list = other.free_list;
+      arena = std::move( other.arena );
+      shared = std::move( other.shared );
+      current = other.current;
+      used = other.used;
+      other.forget();
+    }
+    return *this;
+  }
+
+  /**
+   * Hand out storage for one T, from the free list if it has any
+   * @return uninitialized storage for a T
+   */
+  T * allocate()
+  {
+    if( free_list != nullptr )
+    {
+      Slot * slot = free_list;
+      free_list = slot->next;
+      return reinterpret_cast< T * >( slot );
+    }
+    if( arena == nullptr )
+      arena = std::make_shared< Arena >();
+    auto & chunks = arena->chunks;
+    if( current < chunks.size() && used == chunk_size( current ) )
+    {
+      current++;
+      used = 0;
+    }
+    if( current == chunks.size() )
+      chunks.emplace_back( new Slot[ chunk_size( current ) ] );
+    return reinterpret_cast< T * >( &chunks[ current ][ used++ ] );
+  }
+
+  /**
+   * Take back storage handed out by this pool or one it shares, its T
+   * already destroyed
+   * @param node the storage
+   */
+  void deallocate( T * node )
+  {
+    Slot * slot = reinterpret_cast< Slot * >( node );
+    slot->next = free_list;
+    free_list = slot;
+  }
+
+  /**
+   * Take back every node handed out at once, their Ts already destroyed
+   * or trivially destructible; the chunks are kept
+   * @return false, changing nothing, if another pool shares the arena
+   */
+  bool release_all()
+  {
+    if( arena.use_count() > 1 )
+      return false;
+    free_list = nullptr;
+    current = 0;
+    used = 0;
+    shared.clear();
+    return true;
+  }
+
+  /**
+   * Keep another pool's chunks alive, as this pool's structure is about
+   * to be handed nodes from the other's
+   * @param other the other pool
+   */
+  void share( const NodePool & other )
+  {
+    adopt( other.arena );
+    for( auto & held : other.shared )
+    {
+      adopt( held );
+    }
+  }
+
+  /**
+   * Accessor for the number of slots in the chunks allocated so far
+   * @return the slot count
+   */
+  size_t get_capacity() const
+  {
+    size_t capacity = 0;
+    for( size_t i = 0; arena != nullptr && i < arena->chunks.size(); i++ )
+    {
+      capacity += chunk_size( i );
+    }
+    return capacity;
+  }
+
+ private:
+  /**
+   * Storage for a T, or the link to the next free slot
+   */
+  union Slot
+  {
+    Slot * next;
+    alignas( T ) unsigned char storage[ sizeof( T ) ];
+  };
+
+  /**
+   * The chunks of one pool
+   */
+  struct Arena
+  {
+    std::vector< std::unique_ptr< Slot[] > > chunks;
+  };
+
+  Slot * free_list;
+  std::shared_ptr< Arena > arena;                  // carved from
+  std::vector< std::shared_ptr< Arena > > shared;  // other pools' arenas
+  size_t current; // the chunk new slots are carved from
+  size_t used;    // slots of it handed out so far
+
+  /**
+   * Keep one more arena alive, unless it already is
+   */
+  void adopt( const std::shared_ptr< Arena > & other )
+  {
+    if( other != nullptr && other != arena
+        && std::find( shared.begin(), shared.end(), other ) == shared.end() )
+      shared.push_back( other );
+  }
+
+  /**
+   * Start over empty once another pool has taken the chunks
+   */
+  void forget()
+  {
+    arena.reset();
+    shared.clear();
+    free_list = nullptr;
+    current = 0;
+    used = 0;
+  }
+
+  /**
+   * The number of slots in a chunk
+   */
+  static size_t chunk_size( size_t index )
+  {
+    return index < 16 ? std::min( FIRST_CHUNK << index, MAX_CHUNK )
+      : MAX_CHUNK;
+  }
+};
+
+template< typename T >
+class HeapNodes
+{
+ public:
+  /**
+   * Allocate storage for one T on the heap
+   * @return uninitialized storage for a T
+   */
+  T * allocate()
+  {
+    return static_cast< T * >( ::operator new( sizeof( T ) ) );
+  }
+
+  /**
+   * Free storage handed out by allocate, its T already destroyed
+   * @param node the storage
+   */
+  void deallocate( T * node )
+  {
+    ::operator delete( node );
+  }
+
+  /**
+   * There is no bulk release: every node must be deallocated
+   * @return false
+   */
+  bool release_all()
+  {
+    return false;
+  }
+
+  /**
+   * Nothing to do: heap nodes belong to no pool
+   */
+  void share( const HeapNodes & ) {}
+};
+
+#endif
@@ -0,0 +1,193 @@
+#ifndef MONEY_ORIENTATION
+#define MONEY_ORIENTATION
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+/**
+ * Exact orientation predicates for points on the x-y plane.
+ *
+ * orientation( a, b, c ) is the sign of the cross product of (b - a)
+ * and (c - a): 1 when a, b, c make a counter-clockwise turn, -1 when
+ * clockwise and 0 when collinear. The result is exact for every input:
+ *  - 32-bit integers are evaluated in int64_t when the differences fit
+ *    in 31 bits, and in __int128 otherwise
+ *  - 64-bit integers are evaluated in __int128 and must have magnitude
+ *    below 2^62
+ *  - floating point coordinates go through a floating-point filter and
+ *    fall back to exact expansion arithmetic only when the filter
+ *    cannot certify the sign
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+namespace orientation_detail
+{
+  typedef __int128 wide_t;
+
+  /**
+   * The exact doubled signed area of a, b, c for integer coordinates
+   */
+  template< typename Coord >
+  wide_t integer_area( Coord ax, Coord ay, Coord bx, Coord by,
+                       Coord cx, Coord cy )
+  {
+    static_assert( sizeof( Coord ) <= 8, "coordinates wider than 64 bits" );
+    if constexpr( sizeof( Coord ) <= 4 )
+    {
+      int64_t dbx = int64_t( bx ) - ax, dby = int64_t( by ) - ay;
+      int64_t dcx = int64_t( cx ) - ax, dcy = int64_t( cy ) - ay;
+      // fast path: each product stays below 2^62
+      const int64_t limit = int64_t( 1 ) << 31;
+      if( dbx > -limit && dbx < limit && dby > -limit && dby < limit
+          && dcx > -limit && dcx < limit && dcy > -limit && dcy < limit )
+        return dbx * dcy - dby * dcx;
+      return wide_t( dbx ) * dcy - wide_t( dby ) * dcx;
+    }
+    else
+    {
+      wide_t dbx = wide_t( bx ) - ax, dby = wide_t( by ) - ay;
+      wide_t dcx = wide_t( cx ) - ax, dcy = wide_t( cy ) - ay;
+      return dbx * dcy - dby * dcx;
+    }
+  }
+
+  /**
+   * Compute a + b as an unevaluated sum hi + lo, exactly
+   */
+  inline void two_sum( double a, double b, double & hi, double & lo )
+  {
+    hi = a + b;
+    double b_virtual = hi - a;
+    double a_virtual = hi - b_virtual;
+    lo = ( a - a_virtual ) + ( b - b_virtual );
+  }
+
+  /**
+   * Add b to the nonoverlapping expansion e of length length, keeping
+   * the components in increasing magnitude and dropping zeros
+   * @return the new length of e
+   */
+  inline int grow_expansion( double * e, int length, double b )
+  {
+    double q = b;
+    int kept = 0;
+    for( int i = 0; i < length; i++ )
+    {
+      double hi, lo;
+      two_sum( q, e[ i ], hi, lo );
+      q = hi;
+      if( lo != 0.0 )
+        e[ kept++ ] = lo;
+    }
+    if( q != 0.0 || kept == 0 )
+      e[ kept++ ] = q;
+    return kept;
+  }
+
+  /**
+   * Exact sign of the determinant, summing its six products as an
+   * expansion; every product is split exactly with fma
+   */
+  inline int exact_orientation( double ax, double ay, double bx, double by,
+                                double cx, double cy )
+  {
+    const double terms[ 6 ][ 2 ] = {
+      { bx, cy }, { -bx, ay }, { -ax, cy }, { -by, cx }, { by, ax }, { ay, cx }
+    };
+    double e[ 12 ];
+    int length = 0;
+    for( auto & term : terms )
+    {
+      double product = term[ 0 ] * term[ 1 ];
+      double error = std::fma( term[ 0 ], term[ 1 ], -product );
+      length = grow_expansion( e, length, error );
+      length = grow_expansion( e, length, product );
+    }
+    double top = e[ length - 1 ];
+    return ( top > 0 ) - ( top < 0 );
+  }
+
+  /**
+   * Shewchuk's orient2d filter: the rounded determinant has the right
+   * sign whenever it is larger than its worst-case rounding error
+   */
+  inline int filtered_orientation( double ax, double ay, double bx, double by,
+                                   double cx, double cy )
+  {
+    const double epsilon = std::numeric_limits< double >::epsilon() / 2;
+    const double error_bound = ( 3.0 + 16.0 * epsilon ) * epsilon;
+
+    double detleft = ( ax - cx ) * ( by - cy );
+    double detright = ( ay - cy ) * ( bx - cx );
+    double det = detleft - detright;
+    double detsum;
+
+    if( detleft > 0.0 )
+    {
+      if( detright <= 0.0 )
+        return ( det > 0 ) - ( det < 0 );
+      detsum = detleft + detright;
+    }
+    else if( detleft < 0.0 )
+    {
+      if( detright >= 0.0 )
+        return ( det > 0 ) - ( det < 0 );
+      detsum = -detleft - detright;
+    }
+    else
+    {
+      return ( det > 0 ) - ( det < 0 );
+    }
+
+    double bound = error_bound * detsum;
+    if( det >= bound || -det >= bound )
+      return ( det > 0 ) - ( det < 0 );
+    return exact_orientation( ax, ay, bx, by, cx, cy );
+  }
+}
+
+/**
+ * The turn made by the points a, b, c
+ * @return 1 for counter-clockwise, -1 for clockwise, 0 for collinear
+ */
+template< typename Coord >
+int orientation( Coord ax, Coord ay, Coord bx, Coord by, Coord cx, Coord cy )
+{
+  if constexpr( std::is_floating_point< Coord >::value )
+  {
+    return orientation_detail::filtered_orientation( ax, ay, bx, by, cx, cy );
+  }
+  else
+  {
+    orientation_detail::wide_t area =
+      orientation_detail::integer_area( ax, ay, bx, by, cx, cy );
+    return ( area > 0 ) - ( area < 0 );
+  }
+}
+
+/**
+ * Twice the signed area of the triangle a, b, c, used to compare
+ * distances from a line. Exact for integer coordinates; for floating
+ * point coordinates it is the rounded value and only the sign from
+ * orientation should be relied on.
+ * @return the doubled area, positive when a, b, c turn counter-clockwise
+ */
+template< typename Coord >
+typename std::conditional< std::is_floating_point< Coord >::value,
+                           double, orientation_detail::wide_t >::type
+twice_area( Coord ax, Coord ay, Coord bx, Coord by, Coord cx, Coord cy )
+{
+  if constexpr( std::is_floating_point< Coord >::value )
+  {
+    return ( double( bx ) - ax ) * ( double( cy ) - ay ) -
+      ( double( by ) - ay ) * ( double( cx ) - ax );
+  }
+  else
+  {
+    return orientation_detail::integer_area( ax, ay, bx, by, cx, cy );
+  }
+}
+
+#endif
@@ -0,0 +1,414 @@
+#ifndef MONEY_PERFECT_HASH
+#define MONEY_PERFECT_HASH
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include "hash_functions.h"
+#include "key_file.h"
+#include "mapped_file.h"
+
+/**
+ * A minimal perfect hash function for a static key set, built in the
+ * style of CHD and PTHash: every key maps to its own slot in [0, n)
+ * for n distinct keys, and a lookup is one hash of the key, one pilot
+ * read and two multiplies, with no probing and no stored keys.
+ *
+ * Keys are hashed with a seeded xxHash64 and split into buckets of
+ * about four keys by the high bits of the hash. Buckets are placed
+ * largest first: for each bucket the pilots 0, 1, 2 ... are tried until
+ * mixing the pilot into the hash of every key in the bucket lands each
+ * of them in a distinct free slot, and the winning pilot is recorded.
+ * Only the pilots are kept. Nearly all of them are small, so each is
+ * stored in 16 bits, about 4 bits per key; the few that do not fit are
+ * marked with an escape value and kept in a sorted overflow table.
+ *
+ * save writes a small versioned header, the overflow table and the
+ * pilots, and load memory-maps such a file and reads them in place, so
+ * a table of any size is ready as soon as it is mapped.
+ *
+ * A key that is not in the set still maps to some slot in [0, n).
+ * Keys that repeat in the key file are kept once. The build reseeds
+ * if two different keys share a full 64-bit hash.
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+class PerfectHash
+{
+ public:
+  /**
+   * Construct an empty function; build or load one before lookup
+   */
+  PerfectHash()
+    : pilots{ nullptr }, overflow{ nullptr }, overflow_count{ 0 }, seed{ 0 },
+      key_count{ 0 }, bucket_count{ 0 }, duplicates{ 0 }, op_count{ 0 } {}
+
+  PerfectHash( const PerfectHash & ) = delete;
+  PerfectHash & operator=( const PerfectHash & ) = delete;
+
+  /**
+   * Build the function for every key of a key file
+   * @param keys the key file, one key per line
+   * @param keys_per_bucket the average bucket size; larger buckets
+   *        take fewer pilots but longer to place
+   * @return true if built, false if no seed could be found
+   */
+  bool build( const KeyFile & keys, double keys_per_bucket = 4.0 )
+  {
+    for( uint64_t attempt = 0; attempt < MAX_SEEDS; attempt++ )
+    {
+      if( try_build( keys, keys_per_bucket, attempt ) )
+        return true;
+    }
+    return false;
+  }
+
+  /**
+   * Write the function to a file that load can map
+   * @param path the file to write
+   * @return true if written
+   */
+  bool save( const std::string & path ) const
+  {
+    FILE * file = fopen( path.c_str(), "wb" );
+    if( file == nullptr )
+      return false;
+    Header header{ {}, VERSION, 0, seed, key_count, bucket_count,
+                   overflow_count };
+    memcpy( header.magic, MAGIC, sizeof( header.magic ) );
+    bool written = fwrite( &header, sizeof( header ), 1, file ) == 1 &&
+      fwrite( overflow, sizeof( LargePilot ), overflow_count, file )
+        == overflow_count &&
+      fwrite( pilots, sizeof( uint16_t ), bucket_count, file ) == bucket_count;
+    return fclose( file ) == 0 && written;
+  }
+
+  /**
+   * Map a file written by save and look pilots up in place
+   * @param path the file to map
+   * @return true if the file holds a function of this version
+   */
+  bool load( const std::string & path )
+  {
+    std::unique_ptr< MappedFile > file( new MappedFile( path, false ) );
+    if( !file->is_open() || file->size() < sizeof( Header ) )
+      return false;
+    Header header;
+    memcpy( &header, file->data(), sizeof( header ) );
+    if( memcmp( header.magic, MAGIC, sizeof( header.magic ) ) != 0 ||
+        header.version != VERSION || header.buckets == 0 ||
+        file->size() != sizeof( Header ) + header.overflow
+          * sizeof( LargePilot ) + header.buckets * sizeof( uint16_t ) )
+      return false;
+
+    mapping = std::move( file );
+    owned.clear();
+    owned_overflow.clear();
+    overflow = reinterpret_cast< const LargePilot * >( mapping->data()
+                                                       + sizeof( Header ) );
+    overflow_count = header.overflow;
+    pilots = reinterpret_cast< const uint16_t * >( overflow + overflow_count );
+    seed = header.seed;
+    key_count = header.keys;
+    bucket_count = header.buckets;
+    duplicates = 0;
+    op_count = 0;
+    return true;
+  }
+
+  /**
+   * The slot of a key
+   * @param key the key
+   * @param length the length of the key in bytes
+   * @return a slot in [0, size()), distinct for every key in the set
+   */
+  size_t lookup( const char * key, size_t length ) const
+  {
+    uint64_t hash = xxh64( key, length, seed );
+    size_t bucket = range( hash, bucket_count );
+    uint64_t pilot = pilots[ bucket ];
+    if( pilot == ESCAPE )
+      pilot = large_pilot( bucket );
+    return slot( hash, pilot );
+  }
+
+  /**
+   * The slot of a key
+   * @param key the key
+   * @return a slot in [0, size()), distinct for every key in the set
+   */
+  size_t lookup( const std::string & key ) const
+  {
+    return lookup( key.data(), key.size() );
+  }
+
+  /**
+   * Accessor for the number of keys, which is also the number of slots
+   * @return the number of distinct keys
+   */
+  size_t size() const
+  {
+    return key_count;
+  }
+
+  /**
+   * Accessor for the number of buckets, one pilot each
+   * @return the bucket count
+   */
+  size_t get_bucket_count() const
+  {
+    return bucket_count;
+  }
+
+  /**
+   * Accessor for the size of the function
+   * @return the bits of pilot storage per key
+   */
+  double bits_per_key() const
+  {
+    return key_count > 0 ? 8.0 * ( sizeof( uint16_t ) * bucket_count
+      + sizeof( LargePilot ) * overflow_count ) / key_count : 0.0;
+  }
+
+  /**
+   * Accessor for the repeated keys dropped by the last build
+   * @return the number of duplicate lines
+   */
+  size_t get_duplicates() const
+  {
+    return duplicates;
+  }
+
+  /**
+   * Accessor for the basic operation count of the last build
+   * @return the number of key placements tried
+   */
+  size_t get_op_count() const
+  {
+    return op_count;
+  }
+
+ private:
+  static constexpr char MAGIC[ 8 ] = { 'M', 'O', 'N', 'E', 'Y', 'M', 'P', 'H' };
+  static constexpr uint32_t VERSION = 1;
+  static constexpr uint64_t MAX_SEEDS = 16;
+  static constexpr uint16_t ESCAPE = UINT16_MAX; // the pilot is in overflow
+
+  struct Header
+  {
+    char magic[ 8 ];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t seed;
+    uint64_t keys;
+    uint64_t buckets;
+    uint64_t overflow;
+  };
+
+  struct LargePilot
+  {
+    uint64_t bucket;
+    uint64_t pilot;
+  };
+
+  struct Entry
+  {
+    uint64_t hash;
+    const char * key;
+    size_t length;
+  };
+
+  const uint16_t * pilots; // into owned or mapping
+  const LargePilot * overflow; // sorted by bucket
+  size_t overflow_count;
+  std::vector< uint16_t > owned;
+  std::vector< LargePilot > owned_overflow;
+  std::unique_ptr< MappedFile > mapping;
+  uint64_t seed;
+  size_t key_count;
+  size_t bucket_count;
+  size_t duplicates;
+  size_t op_count;
+
+  /**
+   * Map a hash onto [0, n) with a multiply-shift; this reads the high
+   * bits, so sorting by hash sorts by bucket
+   */
+  static size_t range( uint64_t hash, size_t n )
+  {
+    return size_t( ( ( unsigned __int128 )( hash ) * n ) >> 64 );
+  }
+
+  /**
+   * The slot of a key with the given hash under a pilot
+   */
+  size_t slot( uint64_t hash, uint64_t pilot ) const
+  {
+    using namespace hash_detail;
+    uint64_t pilot_hash = mum( pilot ^ XXH_PRIME_1, XXH_PRIME_2 );
+    return range( mum( hash ^ pilot_hash, XXH_PRIME_3 ), key_count );
+  }
+
+  /**
+   * Binary search the overflow table for an escaped bucket's pilot
+   */
+  uint64_t large_pilot( size_t bucket ) const
+  {
+    const LargePilot * found = std::lower_bound(
+      overflow, overflow + overflow_count, bucket,
+      []( const LargePilot & large, size_t wanted )
+      {
+        return large.bucket < wanted;
+      } );
+    return found->pilot;
+  }
+
+  /**
+   * One build with one seed
+   * @return false if two different keys share a hash or some bucket
+   *         has no pilot, so another seed is needed
+   */
+  bool try_build( const KeyFile & keys, double keys_per_bucket,
+                  uint64_t attempt )
+  {
+    seed = attempt;
+    op_count = 0;
+    std::vector< Entry > entries;
+    keys.for_each_line( 0, keys.size(),
+                        [ this, &entries ]( const char * key, size_t length )
+                        {
+                          entries.push_back( { xxh64( key, length, seed ),
+                                               key, length } );
+                        } );
+    std::sort( entries.begin(), entries.end(),
+               []( const Entry & a, const Entry & b )
+               {
+                 return a.hash < b.hash;
+               } );
+
+    // equal hashes are either one key repeated or a true collision
+    size_t kept = 0;
+    duplicates = 0;
+    for( size_t i = 0; i < entries.size(); i++ )
+    {
+      if( kept > 0 && entries[ kept - 1 ].hash == entries[ i ].hash )
+      {
+        const Entry & last = entries[ kept - 1 ];
+        if( last.length != entries[ i ].length ||
+            memcmp( last.key, entries[ i ].key, last.length ) != 0 )
+          return false;
+        duplicates++;
+      }
+      else
+      {
+        entries[ kept++ ] = entries[ i ];
+      }
+    }
+    entries.resize( kept );
+
+    key_count = entries.size();
+    bucket_count = std::max( size_t( 1 ), size_t( std::ceil(
+      key_count / keys_per_bucket ) ) );
+    std::vector< size_t > starts( bucket_count + 1, 0 );
+    for( auto & entry : entries )
+    {
+      starts[ range( entry.hash, bucket_count ) + 1 ]++;
+    }
+    size_t largest = 0;
+    for( size_t b = 0; b < bucket_count; b++ )
+    {
+      largest = std::max( largest, starts[ b + 1 ] );
+      starts[ b + 1 ] += starts[ b ];
+    }
+
+    // counting sort the buckets by size, largest first
+    std::vector< size_t > by_size( largest + 2, 0 );
+    for( size_t b = 0; b < bucket_count; b++ )
+    {
+      by_size[ largest - ( starts[ b + 1 ] - starts[ b ] ) + 1 ]++;
+    }
+    for( size_t s = 1; s < by_size.size(); s++ )
+    {
+      by_size[ s ] += by_size[ s - 1 ];
+    }
+    std::vector< size_t > order( bucket_count );
+    for( size_t b = 0; b < bucket_count; b++ )
+    {
+      order[ by_size[ largest - ( starts[ b + 1 ] - starts[ b ] ) ]++ ] = b;
+    }
+
+    owned.assign( bucket_count, 0 );
+    owned_overflow.clear();
+    mapping.reset();
+    std::vector< uint64_t > taken( ( key_count + 63 ) / 64, 0 );
+    std::vector< size_t > positions;
+    for( auto b : order )
+    {
+      if( starts[ b + 1 ] == starts[ b ] )
+        break;
+      uint64_t pilot = 0;
+      for( ; pilot <= UINT32_MAX; pilot++ )
+      {
+        if( place( entries, starts[ b ], starts[ b + 1 ], pilot, taken,
+                   positions ) )
+          break;
+      }
+      if( pilot > UINT32_MAX )
+        return false;
+      if( pilot < ESCAPE )
+      {
+        owned[ b ] = uint16_t( pilot );
+      }
+      else
+      {
+        owned[ b ] = ESCAPE;
+        owned_overflow.push_back( { b, pilot } );
+      }
+    }
+
+    std::sort( owned_overflow.begin(), owned_overflow.end(),
+               []( const LargePilot & a, const LargePilot & b )
+               {
+                 return a.bucket < b.bucket;
+               } );
+    pilots = owned.data();
+    overflow = owned_overflow.data();
+    overflow_count = owned_overflow.size();
+    return true;
+  }
+
+  /**
+   * Try one pilot for the bucket of entries [begin, end) and mark its
+   * slots taken if every key gets a distinct free slot
+   * @return true if the pilot places the bucket
+   */
+  bool place( const std::vector< Entry > & entries, size_t begin,
+              size_t end, uint64_t pilot, std::vector< uint64_t > & taken,
+              std::vector< size_t > & positions )
+  {
+    positions.clear();
+    for( size_t i = begin; i < end; i++ )
+    {
+      op_count++;
+      size_t position = slot( entries[ i ].hash, pilot );
+      if( taken[ position / 64 ] & ( uint64_t( 1 ) << ( position % 64 ) ) ||
+          std::find( positions.begin(), positions.end(), position )
+          != positions.end() )
+        return false;
+      positions.push_back( position );
+    }
+    for( auto position : positions )
+    {
+      taken[ position / 64 ] |= uint64_t( 1 ) << ( position % 64 );
+    }
+    return true;
+  }
+};
+
+#endif
@@ -0,0 +1,281 @@
+#ifndef MONEY_POINT_IO
+#define MONEY_POINT_IO
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "mapped_file.h"
+
+/**
+ * Fast point loading for the convex hull programs.
+ *
+ * Text input is whitespace-separated pairs of integers, parsed with a
+ * hand-rolled scanner instead of iostreams, either straight out of a
+ * memory-mapped file or from a stream in large chunks. Binary input is
+ * packed (x, y) pairs of int32 or int64 in native byte order, deinterleaved
+ * directly from the mapped pages into the structure-of-arrays
+ * coordinate vectors with no intermediate buffer. Every loader returns
+ * false on malformed input or on values that do not fit the coordinate
+ * type. An odd trailing value in text input is ignored. The cin loop
+ * these loaders replaced paired such a value with a y of 0 when
+ * whitespace followed it, and dropped it only at the very end of the
+ * input; a half point is no longer made up.
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+
+namespace point_io_detail
+{
+  /**
+   * Report whether c is a whitespace character
+   */
+  inline bool is_space( char c )
+  {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v'
+      || c == '\f';
+  }
+
+  /**
+   * The result of scanning one integer
+   */
+  enum class Scan { OK, BAD, TRUNCATED };
+
+  /**
+   * Scan one optionally signed decimal integer starting at position.
+   * When the digits run into end and more input may follow, the number
+   * may be cut off, so TRUNCATED is returned instead.
+   */
+  template< typename Coord >
+  Scan scan_integer( const char * & position, const char * end, bool last,
+                     Coord & value )
+  {
+    const char * cursor = position;
+    bool negative = false;
+    if( cursor != end && ( *cursor == '-' || *cursor == '+' ) )
+    {
+      negative = *cursor == '-';
+      cursor++;
+    }
+
+    // accumulate toward the sign so the most negative value fits
+    typedef typename std::make_unsigned< Coord >::type Magnitude;
+    const Magnitude limit = negative
+      ? Magnitude( std::numeric_limits< Coord >::max() ) + 1
+      : Magnitude( std::numeric_limits< Coord >::max() );
+    const Magnitude tenth = limit / 10;
+    const unsigned last_digit = limit % 10;
+    Magnitude magnitude = 0;
+    const char * digits = cursor;
+    for( ; cursor != end; cursor++ )
+    {
+      unsigned digit = static_cast< unsigned char >( *cursor ) - '0';
+      if( digit > 9 )
+        break;
+      if( magnitude >= tenth
+          && ( magnitude > tenth || digit > last_digit ) )
+        return Scan::BAD;
+      magnitude = magnitude * 10 + digit;
+    }
+
+    if( cursor == end && !last )
+      return Scan::TRUNCATED;
+    if( cursor == digits || ( cursor != end && !is_space( *cursor ) ) )
+      return Scan::BAD;
+
+    value = negative ? Coord( -magnitude ) : Coord( magnitude );
+    position = cursor;
+    return Scan::OK;
+  }
+}
+
+/**
+ * Scan whole (x, y) pairs of text out of [begin, end) and pass each to
+ * visit. If more input may follow (last is false), a pair that runs into
+ * end is left for the next call.
+ * @param begin the first character to scan
+ * @param end one past the last character
+ * @param last true if no input follows end
+ * @param visit called as visit( x, y ) for each pair
+ * @param ok set to false on malformed input
+ * @return the first character not consumed
+ */
+template< typename Coord, typename Visitor >
+const char * scan_points( const char * begin, const char * end, bool last,
+                          Visitor & visit, bool & ok )
+{
+  using point_io_detail::Scan;
+  using point_io_detail::is_space;
+
+  const char * position = begin;
+  while( true )
+  {
+    while( position != end && is_space( *position ) )
+      position++;
+    const char * pair_start = position;
+    if( position == end )
+      return position;
+
+    Coord x;
+    Coord y;
+    Scan scanned = point_io_detail::scan_integer( position, end, last, x );
+    if( scanned == Scan::TRUNCATED )
+      return pair_start;
+    if( scanned == Scan::BAD )
+    {
+      ok = false;
+      return position;
+    }
+
+    while( position != end && is_space( *position ) )
+      position++;
+    if( position == end )
+      return last ? position : pair_start;
+
+    scanned = point_io_detail::scan_integer( position, end, last, y );
+    if( scanned == Scan::TRUNCATED )
+      return pair_start;
+    if( scanned == Scan::BAD )
+    {
+      ok = false;
+      return position;
+    }
+    visit( x, y );
+  }
+}
+
+/**
+ * Scan text pairs from an open stream in large chunks, passing each
+ * pair to visit, so input of any length uses a fixed-size buffer
+ * @param stream the stream to read, e.g. stdin
+ * @param visit called as visit( x, y ) for each pair
+ * @return true if all input was well formed
+ */
+template< typename Coord, typename Visitor >
+bool scan_points( FILE * stream, Visitor & visit )
+{
+  const size_t chunk = 1 << 20;
+  std::vector< char > buffer( chunk );
+  size_t carried = 0;
+  bool ok = true;
+
+  while( ok )
+  {
+    if( carried == buffer.size() )
+      buffer.resize( 2 * buffer.size() );
+    size_t got = fread( buffer.data() + carried, 1, buffer.size() - carried,
+                        stream );
+    bool last = got == 0;
+    const char * end = buffer.data() + carried + got;
+    const char * rest = scan_points< Coord >( buffer.data(), end, last,
+                                              visit, ok );
+    if( last )
+      break;
+    carried = end - rest;
+    memmove( buffer.data(), rest, carried );
+  }
+  return ok;
+}
+
+/**
+ * Read text pairs from a stream into the coordinate vectors
+ * @param stream the stream to read, e.g. stdin
+ * @param xcoords stores the x values in a vector
+ * @param ycoords stores the y values in a vector
+ * @return true if all input was well formed
+ */
+template< typename Coord >
+bool read_text_points( FILE * stream, std::vector< Coord > & xcoords,
+                       std::vector< Coord > & ycoords )
+{
+  auto append = [ &xcoords, &ycoords ]( Coord x, Coord y )
+    {
+      xcoords.push_back( x );
+      ycoords.push_back( y );
+    };
+  return scan_points< Coord >( stream, append );
+}
+
+/**
+ * Memory-map a text file of pairs and parse it into the coordinate
+ * vectors
+ * @param path the file to load
+ * @param xcoords stores the x values in a vector
+ * @param ycoords stores the y values in a vector
+ * @return true if the file was read and well formed
+ */
+template< typename Coord >
+bool load_text_points( const std::string & path,
+                       std::vector< Coord > & xcoords,
+                       std::vector< Coord > & ycoords )
+{
+  MappedFile file( path );
+  if( !file.is_open() )
+    return false;
+
+  // a generous guess: the shortest pair "0 0\n" is four bytes
+  xcoords.reserve( xcoords.size() + file.size() / 8 );
+  ycoords.reserve( ycoords.size() + file.size() / 8 );
+
+  bool ok = true;
+  auto append = [ &xcoords, &ycoords ]( Coord x, Coord y )
+    {
+      xcoords.push_back( x );
+      ycoords.push_back( y );
+    };
+  scan_points< Coord >( file.data(), file.data() + file.size(), true,
+                        append, ok );
+  return ok;
+}
+
+/**
+ * Memory-map a file of packed binary (x, y) pairs of Stored integers in
+ * native byte order and deinterleave it straight into the coordinate
+ * vectors
+ * @param path the file to load
+ * @param xcoords stores the x values in a vector
+ * @param ycoords stores the y values in a vector
+ * @return true if the file was read, is a whole number of pairs and
+ * every value fits in Coord
+ */
+template< typename Stored, typename Coord >
+bool load_binary_points( const std::string & path,
+                         std::vector< Coord > & xcoords,
+                         std::vector< Coord > & ycoords )
+{
+  MappedFile file( path );
+  if( !file.is_open() || file.size() % ( 2 * sizeof( Stored ) ) != 0 )
+    return false;
+
+  size_t count = file.size() / ( 2 * sizeof( Stored ) );
+  size_t offset = xcoords.size();
+  xcoords.resize( offset + count );
+  ycoords.resize( offset + count );
+
+  const char * pair = file.data();
+  bool fits = true;
+  for( size_t i = 0; i < count; i++, pair += 2 * sizeof( Stored ) )
+  {
+    Stored x;
+    Stored y;
+    memcpy( &x, pair, sizeof( Stored ) );
+    memcpy( &y, pair + sizeof( Stored ), sizeof( Stored ) );
+    xcoords[ offset + i ] = Coord( x );
+    ycoords[ offset + i ] = Coord( y );
+    if( sizeof( Stored ) > sizeof( Coord ) )
+      fits &= Stored( Coord( x ) ) == x && Stored( Coord( y ) ) == y;
+  }
+
+  if( !fits )
+  {
+    xcoords.resize( offset );
+    ycoords.resize( offset );
+  }
+  return fits;
+}
+
+#endif
@@ -0,0 +1,145 @@
+/**
+ * throughput benchmark for the point loaders in point_io.h
+ *
+ * writes the same random points as a text file and as packed int32 and
+ * int64 binary files, then reads each back and reports GB/s for the
+ * original iostream loop from convex_hull.cpp, the chunked stream
+ * scanner, the memory-mapped text scanner and the two binary loaders.
+ * every loader must produce the same coordinates as the iostream loop
+ *
+ * usage: point_io_bench [point count] [scratch directory]
+ *
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "point_io.h"
+
+using namespace std;
+
+/**
+ * Time one loader and print its throughput
+ * @param name the name of the loader
+ * @param path the file the loader reads, used for its size
+ * @param load reads the file into the coordinate vectors
+ * @param xexpected the x values every loader must produce
+ * @param yexpected the y values every loader must produce
+ * @return true if the loader succeeded and matched
+ */
+bool run( const string & name, const string & path,
+          const function< bool( vector< int > &, vector< int > & ) > & load,
+          const vector< int > & xexpected, const vector< int > & yexpected );
+
+int main( int argc, char * argv[] )
+{
+  size_t n = argc > 1 ? strtoul( argv[ 1 ], nullptr, 10 ) : 10000000;
+  string directory = argc > 2 ? argv[ 2 ] : "/tmp";
+  string text_path = directory + "/point_io_bench.txt";
+  string int32_path = directory + "/point_io_bench.i32";
+  string int64_path = directory + "/point_io_bench.i64";
+
+  // write the three files
+  mt19937 generator( 320 );
+  uniform_int_distribution< int > coordinate( -1000000000, 1000000000 );
+  vector< int > xcoords( n );
+  vector< int > ycoords( n );
+  {
+    ofstream text( text_path );
+    ofstream int32( int32_path, ios::binary );
+    ofstream int64( int64_path, ios::binary );
+    for( size_t i = 0; i < n; i++ )
+    {
+      xcoords[ i ] = coordinate( generator );
+      ycoords[ i ] = coordinate( generator );
+      text << xcoords[ i ] << ' ' << ycoords[ i ] << '\n';
+      int32_t narrow[ 2 ] = { xcoords[ i ], ycoords[ i ] };
+      int64_t wide[ 2 ] = { xcoords[ i ], ycoords[ i ] };
+      int32.write( reinterpret_cast< char * >( narrow ), sizeof( narrow ) );
+      int64.write( reinterpret_cast< char * >( wide ), sizeof( wide ) );
+    }
+  }
+
+  cout << left << setw( 16 ) << "loader" << setw( 10 ) << "MB"
+       << setw( 10 ) << "ms" << setw( 10 ) << "GB/s" << "match" << endl;
+
+  bool valid = true;
+  valid &= run( "iostream", text_path,
+                [ &text_path ]( vector< int > & xs, vector< int > & ys )
+                {
+                  // the loop convex_hull.cpp used to read cin with
+                  ifstream in( text_path );
+                  while( ! in.eof() )
+                  {
+                    int value;
+                    if( in >> value && ! in.eof() )
+                    {
+                      xs.push_back( value );
+                      in >> value;
+                      ys.push_back( value );
+                    }
+                  }
+                  return true;
+                }, xcoords, ycoords );
+  valid &= run( "stream scanner", text_path,
+                [ &text_path ]( vector< int > & xs, vector< int > & ys )
+                {
+                  FILE * in = fopen( text_path.c_str(), "r" );
+                  if( in == nullptr )
+                    return false;
+                  bool ok = read_text_points( in, xs, ys );
+                  fclose( in );
+                  return ok;
+                }, xcoords, ycoords );
+  valid &= run( "mmap text", text_path,
+                [ &text_path ]( vector< int > & xs, vector< int > & ys )
+                {
+                  return load_text_points( text_path, xs, ys );
+                }, xcoords, ycoords );
+  valid &= run( "mmap int32", int32_path,
+                [ &int32_path ]( vector< int > & xs, vector< int > & ys )
+                {
+                  return load_binary_points< int32_t >( int32_path, xs, ys );
+                }, xcoords, ycoords );
+  valid &= run( "mmap int64", int64_path,
+                [ &int64_path ]( vector< int > & xs, vector< int > & ys )
+                {
+                  return load_binary_points< int64_t >( int64_path, xs, ys );
+                }, xcoords, ycoords );
+
+  remove( text_path.c_str() );
+  remove( int32_path.c_str() );
+  remove( int64_path.c_str() );
+  return valid ? 0 : 1;
+}
+
+bool run( const string & name, const string & path,
+          const function< bool( vector< int > &, vector< int > & ) > & load,
+          const vector< int > & xexpected, const vector< int > & yexpected )
+{
+  MappedFile file( path );
+  double bytes = file.size();
+
+  vector< int > xcoords;
+  vector< int > ycoords;
+  auto start = chrono::steady_clock::now();
+  bool ok = load( xcoords, ycoords );
+  auto stop = chrono::steady_clock::now();
+
+  double seconds = chrono::duration< double >( stop - start ).count();
+  bool match = ok && xcoords == xexpected && ycoords == yexpected;
+  cout << left << setw( 16 ) << name << setw( 10 ) << bytes / 1e6
+       << setw( 10 ) << seconds * 1e3 << setw( 10 ) << bytes / seconds / 1e9
+       << ( match ? "yes" : "NO" ) << endl;
+  return match;
+}
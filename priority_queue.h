@@ -4,6 +4,8 @@
 #include <cassert>
 #include <cstdint>
 #include <climits>
+#include <cstddef>
+#include <utility>
 #include <vector>
 
 /**
@@ -212,6 +214,185 @@ class PQ
      }
   }
 };
+
+/**
+ * An indexed binary min-heap over the ids 0 through capacity - 1, for
+ * algorithms such as Prim's that lower the priority of an entry already
+ * in the queue. Each id is in the heap at most once and its index in
+ * the heap is tracked, so decrease_key finds it in O(1) and moves it up
+ * in O(log n). Counts one basic operation per level an entry moves.
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+class IndexedPQ
+{
+ public:
+  /**
+   * Construct an empty priority queue
+   * @param capacity one more than the largest id that will be inserted
+   */
+  explicit IndexedPQ( size_t capacity )
+    : position( capacity, ABSENT ), op_count{ 0 } {}
+
+  /**
+   * Insert an id that is not in the queue
+   * @param id the id to insert
+   * @param priority its priority; smaller comes out first
+   */
+  void insert( uint id, uint priority )
+  {
+    assert( !contains( id ) );
+    heap.push_back( { priority, id } );
+    position.at( id ) = heap.size() - 1;
+    bubble_up( heap.size() - 1 );
+  }
+
+  /**
+   * Lower the priority of an id in the queue
+   * @param id the id to update
+   * @param priority its new priority, no larger than the current one
+   */
+  void decrease_key( uint id, uint priority )
+  {
+    assert( contains( id ) && priority <= get_priority( id ) );
+    heap[ position[ id ] ].priority = priority;
+    bubble_up( position[ id ] );
+  }
+
+  /**
+   * Insert an id, or lower its priority if it is in the queue with a
+   * larger one
+   * @param id the id to insert or update
+   * @param priority the priority offered
+   * @return true if the queue changed
+   */
+  bool insert_or_decrease( uint id, uint priority )
+  {
+    if( !contains( id ) )
+    {
+      insert( id, priority );
+      return true;
+    }
+    if( priority >= get_priority( id ) )
+      return false;
+    decrease_key( id, priority );
+    return true;
+  }
+
+  /**
+   * Takes the id with the smallest priority off of the heap
+   * @return the removed id
+   */
+  uint remove()
+  {
+    assert( !heap.empty() );
+    uint id = heap.front().id;
+    swap( 0, heap.size() - 1 );
+    heap.pop_back();
+    position[ id ] = ABSENT;
+    if( !heap.empty() )
+      bubble_down( 0 );
+    return id;
+  }
+
+  /**
+   * Accessor to determine whether an id is in the queue
+   * @param id the id to look for
+   * @return true if the id is waiting in the queue
+   */
+  bool contains( uint id ) const
+  {
+    return position.at( id ) != ABSENT;
+  }
+
+  /**
+   * Accessor for the priority of an id in the queue
+   * @param id an id in the queue
+   * @return its priority
+   */
+  uint get_priority( uint id ) const
+  {
+    return heap.at( position.at( id ) ).priority;
+  }
+
+  /**
+   * Report if the queue is empty
+   * @return true if empty, false otherwise
+   */
+  bool is_empty() const
+  {
+    return heap.empty();
+  }
+
+  /**
+   * Return the number of basic operations counted so far
+   * @return the count of basic operations
+   */
+  size_t get_op_count() const
+  {
+    return op_count;
+  }
+
+ private:
+  static constexpr size_t ABSENT = SIZE_MAX;
+
+  struct Entry
+  {
+    uint priority;
+    uint id;
+  };
+
+  std::vector< Entry > heap;
+  std::vector< size_t > position; // index in heap of each id, or ABSENT
+  size_t op_count;
+
+  /**
+   * Swap two heap entries and keep their positions up to date
+   */
+  void swap( size_t pos1_index, size_t pos2_index )
+  {
+    std::swap( heap[ pos1_index ], heap[ pos2_index ] );
+    position[ heap[ pos1_index ].id ] = pos1_index;
+    position[ heap[ pos2_index ].id ] = pos2_index;
+  }
+
+  /**
+   * Move the entry at index up until its parent is no larger
+   * @param index the index of the entry to percolate up
+   */
+  void bubble_up( size_t index )
+  {
+    op_count++;
+    while( index > 0 && heap[ index ].priority
+           < heap[ ( index - 1 ) / 2 ].priority )
+    {
+      op_count++;
+      swap( index, ( index - 1 ) / 2 );
+      index = ( index - 1 ) / 2;
+    }
+  }
+
+  /**
+   * Move the entry at index down until both children are no smaller
+   * @param index the index of the entry to percolate down
+   */
+  void bubble_down( size_t index )
+  {
+    op_count++;
+    while( 2 * index + 1 < heap.size() )
+    {
+      size_t child = 2 * index + 1;
+      if( child + 1 < heap.size() &&
+          heap[ child + 1 ].priority < heap[ child ].priority )
+        child++;
+      if( heap[ index ].priority <= heap[ child ].priority )
+        return;
+      op_count++;
+      swap( index, child );
+      index = child;
+    }
+  }
+};
 #endif
 
 
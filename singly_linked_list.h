@@ -2,15 +2,42 @@
 #define MONEY_LIST
 
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <iterator>
+#include <new>
 #include <sstream>
+#include <type_traits>
+#include <utility>
+#include "node_pool.h"
 
 /**
  * a simple generic singly linked list class to illustrate C++ concepts
+ *
+ * Nodes come from the Allocator, by default a NodePool that carves them
+ * out of contiguous chunks and recycles the ones popped, so pushes and
+ * pops in steady state never reach the heap allocator; HeapNodes gives
+ * one heap allocation per node instead. clear hands every node back to
+ * a NodePool at once, without visiting them if Object needs no
+ * destructor.
+ *
+ * Moving a list hands over its nodes, and its allocator with them, in
+ * O(1); emplace_front and emplace_back build the element in its node.
+ * The nodes are linked both ways, so iterator and const_iterator are
+ * bidirectional and end() can be stepped back from, for range-based for
+ * loops and the std algorithms.
+ *
+ * splice moves elements from one list, or one place in a list, to
+ * another by relinking their nodes, in O(1) for a whole list, a single
+ * element or a range whose length is given; merge interleaves two
+ * sorted lists in one linear pass and sort is a stable bottom-up merge
+ * sort. None of them copies, moves or allocates an element: only the
+ * links change, and the nodes stay in whichever pool they came from.
  * @author Garrett Money
  * @version 28 January 2018
  */
-template< typename Object >
+template< typename Object, template< typename > class Allocator = NodePool >
 class List
 {
  private:
@@ -22,17 +49,107 @@ class List
    public:
      /**
       * The constructor
-      * @param value the data to be stored in this node
+      * @param args the arguments to construct the stored data from
       */
-      explicit Node( const Object & value )
-        : data{ value }, next{ nullptr }, previous{ nullptr } {}
-    
+      template< typename... Args >
+      explicit Node( Args &&... args )
+        : data( std::forward< Args >( args )... ), next{ nullptr },
+          previous{ nullptr } {}
+
     Object data;
     Node * next;
     Node * previous;
   };
 
  public:
+  /**
+   * A position in the list, end() being one past the last element
+   */
+  template< bool Constant >
+  class Iterator
+  {
+   public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef Object value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef typename std::conditional< Constant, const Object *,
+                                       Object * >::type pointer;
+    typedef typename std::conditional< Constant, const Object &,
+                                       Object & >::type reference;
+
+    Iterator() : node{ nullptr }, list{ nullptr } {}
+
+    /**
+     * Any iterator converts to a const_iterator
+     */
+    operator Iterator< true >() const
+    {
+      return Iterator< true >( node, list );
+    }
+
+    reference operator*() const
+    {
+      return node->data;
+    }
+
+    pointer operator->() const
+    {
+      return &node->data;
+    }
+
+    Iterator & operator++()
+    {
+      node = node->next;
+      return *this;
+    }
+
+    Iterator operator++( int )
+    {
+      Iterator before = *this;
+      node = node->next;
+      return before;
+    }
+
+    Iterator & operator--()
+    {
+      node = node == nullptr ? list->last : node->previous;
+      return *this;
+    }
+
+    Iterator operator--( int )
+    {
+      Iterator before = *this;
+      --*this;
+      return before;
+    }
+
+    template< bool Other >
+    bool operator==( const Iterator< Other > & other ) const
+    {
+      return node == other.node;
+    }
+
+    template< bool Other >
+    bool operator!=( const Iterator< Other > & other ) const
+    {
+      return node != other.node;
+    }
+
+   private:
+    friend class List;
+    template< bool > friend class Iterator;
+
+    Iterator( Node * node, const List * list ) : node{ node }, list{ list } {}
+
+    Node * node;
+    const List * list;
+  };
+
+  typedef Iterator< false > iterator;
+  typedef Iterator< true > const_iterator;
+  typedef std::reverse_iterator< iterator > reverse_iterator;
+  typedef std::reverse_iterator< const_iterator > const_reverse_iterator;
+
   /**
    * The constructor for an empty list
    */
@@ -51,8 +168,8 @@ class List
       auto itr = rhs.first->next;
       for( uint i = 1; i < rhs.size; i++ )
       {
-        Node * new_node = new Node{ itr->data };
-	new_node->previous = last;
+        Node * new_node = create( itr->data );
+        new_node->previous = last;
         last->next = new_node;
         last = new_node;
         itr = itr->next;
@@ -61,6 +178,18 @@ class List
     }
   }
 
+  /**
+   * the move constructor, which takes over rhs's nodes and leaves it
+   * empty
+   */
+  List( List && rhs )
+    : size{ rhs.size }, first{ rhs.first }, last{ rhs.last },
+      nodes{ std::move( rhs.nodes ) }
+  {
+    rhs.size = 0;
+    rhs.first = rhs.last = nullptr;
+  }
+
   /**
    * the operator= method
    */
@@ -69,11 +198,7 @@ class List
     if( this != &rhs )
     {
       // first need to reclaim all space used by current nodes
-      uint count = size;
-      for( uint i = 0; i < count; i++ )
-      {
-        pop_front();
-      }
+      clear();
 
       // now need to copy the elements
       for( auto itr = rhs.first; itr != nullptr; itr = itr->next )
@@ -84,24 +209,54 @@ class List
     return *this;
   }
 
+  /**
+   * the move operator= method, which takes over rhs's nodes and leaves
+   * it empty
+   */
+  List & operator=( List && rhs )
+  {
+    if( this != &rhs )
+    {
+      clear();
+      nodes = std::move( rhs.nodes );
+      size = rhs.size;
+      first = rhs.first;
+      last = rhs.last;
+      rhs.size = 0;
+      rhs.first = rhs.last = nullptr;
+    }
+    return *this;
+  }
+
   /**
    * The destructor that gets rid of everything that's in the list and
    * resets it to empty. If the list is already empty, do nothing.
    */
   ~List()
   {
-    if( size != 0 )
+    clear();
+  }
+
+  /**
+   * Remove every element, handing all the nodes back to the allocator
+   * at once if it can take them that way
+   */
+  void clear()
+  {
+    if( !std::is_trivially_destructible< Object >::value
+        || !nodes.release_all() )
     {
       Node * current = first;
-      Node * temp;
-
-      for( uint i = 0; i < size; i++ )
+      while( current != nullptr )
       {
-        temp = current;
+        Node * temp = current;
         current = current->next;
-        delete temp;
+        destroy( temp );
       }
+      nodes.release_all();
     }
+    first = last = nullptr;
+    size = 0;
   }
 
   /**
@@ -110,7 +265,27 @@ class List
    */
   void push_front( const Object & item )
   {
-    auto new_node = new Node{ item };
+    emplace_front( item );
+  }
+
+  /**
+   * Move a new element onto the beginning of the list
+   * @param item the data the new element will take over
+   */
+  void push_front( Object && item )
+  {
+    emplace_front( std::move( item ) );
+  }
+
+  /**
+   * Put a new element built in place onto the beginning of the list
+   * @param args the arguments to construct the element from
+   * @return the new element
+   */
+  template< typename... Args >
+  Object & emplace_front( Args &&... args )
+  {
+    auto new_node = create( std::forward< Args >( args )... );
 
     if( is_empty() )
     {
@@ -123,15 +298,37 @@ class List
       first = new_node;
     }
     size++;
+    return new_node->data;
   }
+
   /**
    * Put a new element onto the end of the list
    * @param item the data the new element will contain
    */
   void push_back( const Object & item )
   {
-    auto new_node = new Node( item );
-    
+    emplace_back( item );
+  }
+
+  /**
+   * Move a new element onto the end of the list
+   * @param item the data the new element will take over
+   */
+  void push_back( Object && item )
+  {
+    emplace_back( std::move( item ) );
+  }
+
+  /**
+   * Put a new element built in place onto the end of the list
+   * @param args the arguments to construct the element from
+   * @return the new element
+   */
+  template< typename... Args >
+  Object & emplace_back( Args &&... args )
+  {
+    auto new_node = create( std::forward< Args >( args )... );
+
     if( is_empty() )
     {
       first = last = new_node;
@@ -143,6 +340,7 @@ class List
       last = new_node;
     }
     size++;
+    return new_node->data;
   }
 
   /**
@@ -161,8 +359,9 @@ class List
     else
     {
       first = first->next;
+      first->previous = nullptr;
     }
-    delete temp;
+    destroy( temp );
     size--;
   }
 
@@ -184,7 +383,7 @@ class List
       last = last->previous;
       last->next = nullptr;
     }
-    delete temp;
+    destroy( temp );
     size--;
   }
 
@@ -208,19 +407,19 @@ class List
       push_front( item );
     }
     //When pos is last, push back
-    if( pos == size )
+    else if( pos == size )
     {
       push_back( item );
     }
     //if pos is in the middle, track through list and insert
-    if( pos > 0 && pos < size )
+    else
     {
       //Calculate if back-to-front or front-to-back tracking is more
       //efficient for finding the previous position to pos
       if( pos > ( size / 2 ) )
       {
 	current = last;
-	for( uint i = size; i > pos - 1; i-- )
+	for( uint i = size - 1; i > pos - 1; i-- )
 	{
           current = current->previous;
 	}
@@ -234,8 +433,8 @@ class List
         }	
       }
       //create a new node to insert
-      auto new_node = new Node( item );
-    
+      auto new_node = create( item );
+
       //insert the new node with the same next and previous as the originally 
       //positioned node
       new_node->next = current->next;
@@ -251,6 +450,165 @@ class List
     }
   }
   
+  /**
+   * Move every element of another list in front of position, leaving the
+   * other list empty, in O(1)
+   * @param position where the elements go, an iterator of this list
+   * @param other the list they come from
+   */
+  void splice( const_iterator position, List & other )
+  {
+    if( &other != this && !other.is_empty() )
+      transfer( position, other, other.first, other.last, other.size );
+  }
+
+  /**
+   * Move one element of a list, this one or another, in front of
+   * position, in O(1)
+   * @param position where the element goes, an iterator of this list
+   * @param other the list it comes from
+   * @param element the element, an iterator of other
+   */
+  void splice( const_iterator position, List & other, const_iterator element )
+  {
+    transfer( position, other, element.node, element.node, 1 );
+  }
+
+  /**
+   * Move the elements [from, to) of a list, this one or another, in
+   * front of position; for another list, counting them takes O(count)
+   * @param position where they go, an iterator of this list and not in
+   *        the range
+   * @param other the list they come from
+   * @param from the first of them, an iterator of other
+   * @param to the element after the last of them, an iterator of other
+   */
+  void splice( const_iterator position, List & other, const_iterator from,
+               const_iterator to )
+  {
+    uint count = &other == this ? 0 : uint( std::distance( from, to ) );
+    splice( position, other, from, to, count );
+  }
+
+  /**
+   * Move the elements [from, to) of a list in front of position in O(1),
+   * given how many there are
+   * @param position where they go, an iterator of this list and not in
+   *        the range
+   * @param other the list they come from
+   * @param from the first of them, an iterator of other
+   * @param to the element after the last of them, an iterator of other
+   * @param count the number of elements in the range
+   */
+  void splice( const_iterator position, List & other, const_iterator from,
+               const_iterator to, uint count )
+  {
+    assert( &other == this || count == uint( std::distance( from, to ) ) );
+    if( from != to )
+      transfer( position, other, from.node, ( --to ).node, count );
+  }
+
+  /**
+   * Merge another sorted list into this sorted one in one linear pass,
+   * leaving the other empty; of equal elements this list's come first
+   * @param other the list to merge in
+   */
+  void merge( List & other )
+  {
+    merge( other, std::less< Object >() );
+  }
+
+  /**
+   * Merge another list into this one, both sorted by less, in one linear
+   * pass, leaving the other empty; of equal elements this list's come
+   * first
+   * @param other the list to merge in
+   * @param less the strict weak order both lists are sorted by
+   */
+  template< typename Compare >
+  void merge( List & other, Compare less )
+  {
+    if( &other == this || other.is_empty() )
+      return;
+    nodes.share( other.nodes );
+    if( is_empty() )
+    {
+      first = other.first;
+      last = other.last;
+    }
+    else
+    {
+      first = merge_runs( first, last, other.first, other.last, less,
+                          last );
+      first->previous = nullptr;
+    }
+    size += other.size;
+    other.first = other.last = nullptr;
+    other.size = 0;
+  }
+
+  /**
+   * Sort the list, keeping equal elements in order, by relinking nodes
+   */
+  void sort()
+  {
+    sort( std::less< Object >() );
+  }
+
+  /**
+   * Sort the list by less with a stable bottom-up merge sort that only
+   * relinks nodes: O(n log n) comparisons, no element copied, no memory
+   * allocated
+   * @param less the strict weak order to sort by
+   */
+  template< typename Compare >
+  void sort( Compare less )
+  {
+    if( size < 2 )
+      return;
+
+    // runs[ i ] to ends[ i ] is a sorted run of 2^i nodes or empty,
+    // older runs of the list at higher i
+    Node * runs[ RUNS ] = {};
+    Node * ends[ RUNS ] = {};
+    size_t height = 0;
+    Node * current = first;
+    while( current != nullptr )
+    {
+      Node * carry = current;
+      Node * carry_end = current;
+      current = current->next;
+      carry->next = carry->previous = nullptr;
+      size_t i = 0;
+      for( ; i < height && runs[ i ] != nullptr; i++ )
+      {
+        carry = merge_runs( runs[ i ], ends[ i ], carry, carry_end, less,
+                            carry_end );
+        runs[ i ] = nullptr;
+      }
+      runs[ i ] = carry;
+      ends[ i ] = carry_end;
+      if( i == height )
+        height++;
+    }
+    first = nullptr;
+    for( size_t i = 0; i < height; i++ )
+    {
+      if( runs[ i ] == nullptr )
+        continue;
+      if( first == nullptr )
+      {
+        first = runs[ i ];
+        last = ends[ i ];
+      }
+      else
+      {
+        first = merge_runs( runs[ i ], ends[ i ], first, last, less, last );
+      }
+    }
+    first->previous = nullptr;
+  }
+
   /**
    * Accessor to return the data of the element at the front of the list.
    * Causes an assertion error if the list is empty.
@@ -282,6 +640,70 @@ class List
     return size == 0;
   }
 
+  /**
+   * Iterators over the elements, front to tail
+   * @return the position of the first element, or end() if empty
+   */
+  iterator begin()
+  {
+    return iterator( first, this );
+  }
+
+  const_iterator begin() const
+  {
+    return const_iterator( first, this );
+  }
+
+  const_iterator cbegin() const
+  {
+    return begin();
+  }
+
+  /**
+   * @return the position one past the last element
+   */
+  iterator end()
+  {
+    return iterator( nullptr, this );
+  }
+
+  const_iterator end() const
+  {
+    return const_iterator( nullptr, this );
+  }
+
+  const_iterator cend() const
+  {
+    return end();
+  }
+
+  /**
+   * Iterators over the elements, tail to front
+   * @return the position of the last element, or rend() if empty
+   */
+  reverse_iterator rbegin()
+  {
+    return reverse_iterator( end() );
+  }
+
+  const_reverse_iterator rbegin() const
+  {
+    return const_reverse_iterator( end() );
+  }
+
+  /**
+   * @return the position one before the first element
+   */
+  reverse_iterator rend()
+  {
+    return reverse_iterator( begin() );
+  }
+
+  const_reverse_iterator rend() const
+  {
+    return const_reverse_iterator( begin() );
+  }
+
   /**
    * Generate a string representation of the list
    * Requires operator<< to be defined for the list's object type
@@ -323,9 +745,107 @@ class List
   }
 	
  private:
+  static constexpr size_t RUNS = 8 * sizeof( uint ) + 1;
+
   uint size;
   Node * first;
   Node * last;
+  Allocator< Node > nodes;
+
+  /**
+   * Unlink the nodes head to tail, count of them, from other and link
+   * them in front of position in this list
+   */
+  void transfer( const_iterator position, List & other, Node * head,
+                 Node * tail, uint count )
+  {
+    // already in place
+    if( &other == this
+        && ( position.node == head || position.node == tail->next ) )
+      return;
+
+    Node * before = head->previous;
+    Node * after = tail->next;
+    if( before != nullptr )
+      before->next = after;
+    else
+      other.first = after;
+    if( after != nullptr )
+      after->previous = before;
+    else
+      other.last = before;
+
+    Node * next = position.node;
+    Node * previous = next == nullptr ? last : next->previous;
+    head->previous = previous;
+    tail->next = next;
+    if( previous != nullptr )
+      previous->next = head;
+    else
+      first = head;
+    if( next != nullptr )
+      next->previous = tail;
+    else
+      last = tail;
+
+    if( &other != this )
+    {
+      nodes.share( other.nodes );
+      other.size -= count;
+      size += count;
+    }
+  }
+
+  /**
+   * Merge two nonempty sorted runs, each ending in a null next link, the
+   * nodes of older first on ties; the previous links within the merged
+   * run are set, that of its first node is not
+   * @param merged_end set to the last node of the merged run
+   * @return the first node of the merged run
+   */
+  template< typename Compare >
+  static Node * merge_runs( Node * older, Node * older_end, Node * newer,
+                            Node * newer_end, Compare & less,
+                            Node *& merged_end )
+  {
+    Node * head = nullptr;
+    Node * tail = nullptr;
+    while( older != nullptr && newer != nullptr )
+    {
+      Node * & from = less( newer->data, older->data ) ? newer : older;
+      Node * node = from;
+      from = from->next;
+      node->previous = tail;
+      ( tail == nullptr ? head : tail->next ) = node;
+      tail = node;
+    }
+    Node * rest = older != nullptr ? older : newer;
+    merged_end = older != nullptr ? older_end : newer_end;
+    rest->previous = tail;
+    tail->next = rest;
+    return head;
+  }
+
+  /**
+   * Make a new unlinked node
+   * @param args the arguments to construct its data from
+   * @return the node
+   */
+  template< typename... Args >
+  Node * create( Args &&... args )
+  {
+    return new( nodes.allocate() ) Node( std::forward< Args >( args )... );
+  }
+
+  /**
+   * Destroy an unlinked node and hand it back to the allocator
+   * @param node the node
+   */
+  void destroy( Node * node )
+  {
+    node->~Node();
+    nodes.deallocate( node );
+  }
 };
 
 #endif
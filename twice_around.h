@@ -0,0 +1,132 @@
+#ifndef MONEY_TWICE_AROUND
+#define MONEY_TWICE_AROUND
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "csr_graph.h"
+#include "edge_weights.h"
+
+/**
+ * Steps two and three of the twice-around algorithm: walk the minimum
+ * spanning tree depth first, which passes every tree edge twice, and
+ * shortcut the walk by listing each vertex only when it is first
+ * reached. The result is the tree's preorder, closed back to the
+ * start, and on a graph whose weights obey the triangle inequality it
+ * is at most twice the optimal circuit.
+ *
+ * The walk uses an explicit stack of ( vertex, next tree edge ) pairs,
+ * so deep trees cannot overflow the call stack, and a visited flag per
+ * vertex, so each tree edge is looked at once from each end: O(V) for
+ * the walk. The weight of every step of the circuit, shortcuts and the
+ * closing step included, comes from an EdgeWeights lookup in O(1), so
+ * with the lookup built in O(E) the whole step is O(V + E).
+ *
+ * A shortcut is only a real step if the graph has that edge, which a
+ * complete graph always does. compute reports whether every step was
+ * an edge; a missing one adds nothing to the length. If the tree is a
+ * forest the walk carries on from the lowest unvisited vertex.
+ *
+ * A basic operation is one tree edge examined or one weight looked up.
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+class TwiceAround
+{
+ public:
+  /**
+   * Construct an engine
+   */
+  TwiceAround() : length{ 0 }, op_count{ 0 } {}
+
+  /**
+   * Build the shortcut circuit of a tree
+   * @param mst the tree, every edge in both directions
+   * @param weights the weight lookup of the whole graph
+   * @param start the vertex the circuit starts and ends at
+   * @param circuit set to the vertices in order, start repeated last
+   * @return true if every step of the circuit is an edge of the graph
+   */
+  bool compute( const CSRGraph & mst, EdgeWeights & weights, uint start,
+                std::vector< uint > & circuit )
+  {
+    size_t vertices = mst.size();
+    circuit.clear();
+    length = 0;
+    op_count = 0;
+    if( vertices == 0 )
+      return true;
+
+    std::vector< bool > visited( vertices, false );
+    std::vector< std::pair< uint, size_t > > stack;
+    circuit.reserve( vertices + 1 );
+    for( size_t root = start, count = 0; count < vertices;
+         root = ( root + 1 ) % vertices, count++ )
+    {
+      if( visited[ root ] )
+        continue;
+      visited[ root ] = true;
+      circuit.push_back( root );
+      stack.push_back( { uint( root ), mst.begin( root ) } );
+
+      while( !stack.empty() )
+      {
+        uint vertex = stack.back().first;
+        size_t & next = stack.back().second;
+        if( next == mst.begin( vertex + 1 ) )
+        {
+          stack.pop_back();
+          continue;
+        }
+        op_count++;
+        uint child = mst.target( next++ );
+        if( visited[ child ] )
+          continue;
+        visited[ child ] = true;
+        circuit.push_back( child );
+        stack.push_back( { child, mst.begin( child ) } );
+      }
+    }
+    circuit.push_back( start );
+
+    bool complete = true;
+    for( size_t i = 0; i + 1 < circuit.size(); i++ )
+    {
+      // only a one-vertex circuit steps from a vertex to itself
+      if( circuit[ i ] == circuit[ i + 1 ] )
+        continue;
+      op_count++;
+      uint weight = weights.get( circuit[ i ], circuit[ i + 1 ] );
+      if( weight == EdgeWeights::ABSENT )
+        complete = false;
+      else
+        length += weight;
+    }
+    return complete;
+  }
+
+  /**
+   * Accessor for the length of the last circuit built
+   * @return the sum of the weights of its steps
+   */
+  uint64_t get_length() const
+  {
+    return length;
+  }
+
+  /**
+   * Accessor for the basic operations of the last computation
+   * @return the count of basic operations
+   */
+  size_t get_op_count() const
+  {
+    return op_count;
+  }
+
+ private:
+  uint64_t length;
+  size_t op_count;
+};
+
+#endif
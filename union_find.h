@@ -0,0 +1,180 @@
+#ifndef MONEY_UNION_FIND
+#define MONEY_UNION_FIND
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * Disjoint sets over the elements 0 through size - 1, with union by
+ * rank and path compression, so any sequence of m operations takes
+ * O(m alpha(n)) time. Counts one basic operation per parent link
+ * followed.
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+class UnionFind
+{
+ public:
+  /**
+   * Construct size singleton sets
+   * @param size the number of elements
+   */
+  explicit UnionFind( size_t size )
+    : parent( size ), rank( size, 0 ), sets{ size }, op_count{ 0 }
+  {
+    for( size_t i = 0; i < size; i++ )
+    {
+      parent[ i ] = i;
+    }
+  }
+
+  /**
+   * Find the representative of an element's set, and point every
+   * element on the way straight at it
+   * @param element the element
+   * @return the representative
+   */
+  uint find( uint element )
+  {
+    uint root = element;
+    while( parent[ root ] != root )
+    {
+      op_count++;
+      root = parent[ root ];
+    }
+    while( parent[ element ] != root )
+    {
+      uint next = parent[ element ];
+      parent[ element ] = root;
+      element = next;
+    }
+    return root;
+  }
+
+  /**
+   * Merge the sets of two elements, hanging the shallower tree under
+   * the deeper
+   * @param first an element
+   * @param second an element
+   * @return true if they were in different sets
+   */
+  bool unite( uint first, uint second )
+  {
+    first = find( first );
+    second = find( second );
+    if( first == second )
+      return false;
+    if( rank[ first ] < rank[ second ] )
+      std::swap( first, second );
+    parent[ second ] = first;
+    if( rank[ first ] == rank[ second ] )
+      rank[ first ]++;
+    sets--;
+    return true;
+  }
+
+  /**
+   * Accessor for the number of disjoint sets
+   * @return the set count
+   */
+  size_t set_count() const
+  {
+    return sets;
+  }
+
+  /**
+   * Return the number of basic operations counted so far
+   * @return the count of basic operations
+   */
+  size_t get_op_count() const
+  {
+    return op_count;
+  }
+
+ private:
+  std::vector< uint > parent;
+  std::vector< uint8_t > rank;
+  size_t sets;
+  size_t op_count;
+};
+
+/**
+ * Disjoint sets that many threads may find and unite in at once,
+ * without locks. Every parent is an atomic word. unite links the root
+ * with the larger index under the other with one compare-and-swap,
+ * retrying from fresh roots if another thread linked either first, so
+ * parents only ever point to smaller indices and no cycle can form.
+ * find halves the path as it goes, each shortcut a compare-and-swap
+ * that is simply dropped if another thread changed the link first.
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+class ConcurrentUnionFind
+{
+ public:
+  /**
+   * Construct size singleton sets
+   * @param size the number of elements
+   */
+  explicit ConcurrentUnionFind( size_t size )
+    : parent( new std::atomic< uint >[ size ] )
+  {
+    for( size_t i = 0; i < size; i++ )
+    {
+      parent[ i ].store( i, std::memory_order_relaxed );
+    }
+  }
+
+  /**
+   * Find the representative of an element's set
+   * @param element the element
+   * @return the representative at some moment during the call
+   */
+  uint find( uint element )
+  {
+    while( true )
+    {
+      uint next = parent[ element ].load( std::memory_order_acquire );
+      if( next == element )
+        return element;
+      uint grandparent = parent[ next ].load( std::memory_order_acquire );
+      if( grandparent != next )
+        parent[ element ].compare_exchange_weak( next, grandparent,
+                                                 std::memory_order_acq_rel );
+      element = grandparent;
+    }
+  }
+
+  /**
+   * Merge the sets of two elements
+   * @param first an element
+   * @param second an element
+   * @return true if this call merged two different sets; of several
+   *         threads uniting the same two sets, exactly one sees true
+   */
+  bool unite( uint first, uint second )
+  {
+    while( true )
+    {
+      first = find( first );
+      second = find( second );
+      if( first == second )
+        return false;
+      if( first < second )
+        std::swap( first, second );
+      uint expected = first;
+      if( parent[ first ].compare_exchange_strong( expected, second,
+                                                   std::memory_order_acq_rel ) )
+        return true;
+    }
+  }
+
+ private:
+  std::unique_ptr< std::atomic< uint >[] > parent;
+};
+
+#endif
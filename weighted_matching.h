@@ -0,0 +1,509 @@
+#ifndef MONEY_WEIGHTED_MATCHING
+#define MONEY_WEIGHTED_MATCHING
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+/**
+ * Maximum-weight matching on a general graph with Edmonds' blossom
+ * algorithm in its O(V^3) primal-dual form. Every vertex and blossom
+ * has a dual label; the search grows alternating trees along edges
+ * whose reduced cost is zero, shrinks odd cycles into blossoms, and,
+ * when stuck, moves the labels by the largest amount that keeps them
+ * feasible, which either makes a new edge tight or lets a blossom be
+ * expanded. Each augmentation costs O(V^2), and there are at most V / 2.
+ *
+ * The graph is dense: set_weight fills a V by V table, and a weight of
+ * zero means no edge. Internally vertices are numbered from 1, and
+ * blossoms take the numbers V + 1 through 2V, so index 0 can stand for
+ * none. All weights and labels are 64-bit, so weights up to 2^60 / V
+ * are safe. Memory is O(V^2), so this is for graphs of a few thousand
+ * vertices at most.
+ *
+ * A minimum-weight perfect matching on a complete graph with an even
+ * number of vertices is a maximum-weight matching under the weights
+ * C - w, for any C larger than V / 2 + 1 times the heaviest w, since
+ * then every perfect matching outweighs every smaller one.
+ *
+ * A basic operation is one edge scanned while growing a tree.
+ * @author Garrett Money
+ * @version October 18, 2026
+ */
+class WeightedMatching
+{
+ public:
+  static constexpr uint NONE = UINT32_MAX;
+
+  /**
+   * Construct a graph with no edges
+   * @param vertices the number of vertices
+   */
+  explicit WeightedMatching( size_t vertices )
+    : n{ uint( vertices ) }, n_x{ 0 }, stride{ 2 * vertices + 1 },
+      g( stride * stride ), label( stride, 0 ), match( stride, 0 ),
+      slack( stride, 0 ), st( stride, 0 ), pa( stride, 0 ),
+      flower_from( stride * ( vertices + 1 ), 0 ), S( stride, 0 ),
+      vis( stride, 0 ), flower( stride ), stamp{ 0 }, op_count{ 0 }
+  {
+    for( uint u = 0; u < stride; u++ )
+    {
+      for( uint v = 0; v < stride; v++ )
+      {
+        edge( u, v ) = { u, v, 0 };
+      }
+    }
+  }
+
+  /**
+   * Set the weight of the edge between two vertices
+   * @param u a vertex, from 0
+   * @param v another vertex, from 0
+   * @param weight the weight, positive, or 0 to remove the edge
+   */
+  void set_weight( uint u, uint v, int64_t weight )
+  {
+    edge( u + 1, v + 1 ).w = weight;
+    edge( v + 1, u + 1 ).w = weight;
+  }
+
+  /**
+   * Compute a maximum-weight matching
+   * @return its weight
+   */
+  int64_t compute()
+  {
+    n_x = n;
+    op_count = 0;
+    std::fill( match.begin(), match.end(), 0 );
+    int64_t heaviest = 0;
+    for( uint u = 0; u <= n; u++ )
+    {
+      st[ u ] = u;
+      flower[ u ].clear();
+    }
+    for( uint u = 1; u <= n; u++ )
+    {
+      for( uint v = 1; v <= n; v++ )
+      {
+        from( u, v ) = u == v ? u : 0;
+        heaviest = std::max( heaviest, edge( u, v ).w );
+      }
+    }
+    for( uint u = 1; u <= n; u++ )
+    {
+      label[ u ] = heaviest;
+    }
+    while( augmenting_path() ) {}
+
+    int64_t total = 0;
+    for( uint u = 1; u <= n; u++ )
+    {
+      if( match[ u ] != 0 && match[ u ] < u )
+        total += edge( u, match[ u ] ).w;
+    }
+    return total;
+  }
+
+  /**
+   * Accessor for the vertex matched to another
+   * @param vertex a vertex, from 0
+   * @return its mate, or NONE if it is unmatched
+   */
+  uint get_mate( uint vertex ) const
+  {
+    return match[ vertex + 1 ] == 0 ? NONE : match[ vertex + 1 ] - 1;
+  }
+
+  /**
+   * Accessor for the basic operations of the last computation
+   * @return the count of basic operations
+   */
+  size_t get_op_count() const
+  {
+    return op_count;
+  }
+
+ private:
+  /**
+   * An edge of the original graph; for a blossom, the lightest in
+   * reduced cost from any vertex inside it
+   */
+  struct Link
+  {
+    uint u;
+    uint v;
+    int64_t w;
+  };
+
+  static constexpr int64_t INF = INT64_MAX;
+
+  uint n;
+  uint n_x;                           // highest blossom number in use
+  size_t stride;
+  std::vector< Link > g;
+  std::vector< int64_t > label;
+  std::vector< uint > match;
+  std::vector< uint > slack;          // tightest vertex toward each
+  std::vector< uint > st;             // outermost blossom of each
+  std::vector< uint > pa;             // tree parent, through an edge end
+  std::vector< uint > flower_from;    // sub-blossom holding a vertex
+  std::vector< int > S;               // -1 free, 0 outer, 1 inner
+  std::vector< size_t > vis;
+  std::vector< std::vector< uint > > flower;
+  std::deque< uint > queue;
+  size_t stamp;
+  size_t op_count;
+
+  Link & edge( uint u, uint v )
+  {
+    return g[ u * stride + v ];
+  }
+
+  uint & from( uint blossom, uint vertex )
+  {
+    return flower_from[ blossom * ( n + 1 ) + vertex ];
+  }
+
+  /**
+   * The reduced cost of an edge, twice over so it stays integral
+   */
+  int64_t dist( const Link & e ) const
+  {
+    return label[ e.u ] + label[ e.v ] - e.w * 2;
+  }
+
+  void update_slack( uint u, uint x )
+  {
+    if( slack[ x ] == 0
+        || dist( edge( u, x ) ) < dist( edge( slack[ x ], x ) ) )
+      slack[ x ] = u;
+  }
+
+  void set_slack( uint x )
+  {
+    slack[ x ] = 0;
+    for( uint u = 1; u <= n; u++ )
+    {
+      if( edge( u, x ).w > 0 && st[ u ] != x && S[ st[ u ] ] == 0 )
+        update_slack( u, x );
+    }
+  }
+
+  void push( uint x )
+  {
+    if( x <= n )
+    {
+      queue.push_back( x );
+      return;
+    }
+    for( uint inner : flower[ x ] )
+    {
+      push( inner );
+    }
+  }
+
+  void set_st( uint x, uint blossom )
+  {
+    st[ x ] = blossom;
+    if( x > n )
+    {
+      for( uint inner : flower[ x ] )
+      {
+        set_st( inner, blossom );
+      }
+    }
+  }
+
+  /**
+   * The position of a sub-blossom in its blossom's cycle, reversing the
+   * cycle if needed so the position is even
+   */
+  uint get_pr( uint blossom, uint inner )
+  {
+    std::vector< uint > & cycle = flower[ blossom ];
+    uint pr = std::find( cycle.begin(), cycle.end(), inner ) - cycle.begin();
+    if( pr % 2 == 1 )
+    {
+      std::reverse( cycle.begin() + 1, cycle.end() );
+      return cycle.size() - pr;
+    }
+    return pr;
+  }
+
+  void set_match( uint u, uint v )
+  {
+    match[ u ] = edge( u, v ).v;
+    if( u <= n )
+      return;
+    Link e = edge( u, v );
+    uint xr = from( u, e.u );
+    uint pr = get_pr( u, xr );
+    for( uint i = 0; i < pr; i++ )
+    {
+      set_match( flower[ u ][ i ], flower[ u ][ i ^ 1 ] );
+    }
+    set_match( xr, v );
+    std::rotate( flower[ u ].begin(), flower[ u ].begin() + pr,
+                 flower[ u ].end() );
+  }
+
+  void augment( uint u, uint v )
+  {
+    while( true )
+    {
+      uint xnv = st[ match[ u ] ];
+      set_match( u, v );
+      if( xnv == 0 )
+        return;
+      set_match( xnv, st[ pa[ xnv ] ] );
+      u = st[ pa[ xnv ] ];
+      v = xnv;
+    }
+  }
+
+  uint get_lca( uint u, uint v )
+  {
+    for( ++stamp; u != 0 || v != 0; std::swap( u, v ) )
+    {
+      if( u == 0 )
+        continue;
+      if( vis[ u ] == stamp )
+        return u;
+      vis[ u ] = stamp;
+      u = st[ match[ u ] ];
+      if( u != 0 )
+        u = st[ pa[ u ] ];
+    }
+    return 0;
+  }
+
+  void add_blossom( uint u, uint lca, uint v )
+  {
+    uint b = n + 1;
+    while( b <= n_x && st[ b ] != 0 )
+      b++;
+    if( b > n_x )
+      n_x++;
+    label[ b ] = 0;
+    S[ b ] = 0;
+    match[ b ] = match[ lca ];
+    flower[ b ].clear();
+    flower[ b ].push_back( lca );
+    for( uint x = u, y; x != lca; x = st[ pa[ y ] ] )
+    {
+      flower[ b ].push_back( x );
+      flower[ b ].push_back( y = st[ match[ x ] ] );
+      push( y );
+    }
+    std::reverse( flower[ b ].begin() + 1, flower[ b ].end() );
+    for( uint x = v, y; x != lca; x = st[ pa[ y ] ] )
+    {
+      flower[ b ].push_back( x );
+      flower[ b ].push_back( y = st[ match[ x ] ] );
+      push( y );
+    }
+    set_st( b, b );
+    for( uint x = 1; x <= n_x; x++ )
+    {
+      edge( b, x ).w = 0;
+      edge( x, b ).w = 0;
+    }
+    for( uint x = 1; x <= n; x++ )
+    {
+      from( b, x ) = 0;
+    }
+    for( uint xs : flower[ b ] )
+    {
+      for( uint x = 1; x <= n_x; x++ )
+      {
+        if( edge( b, x ).w == 0
+            || dist( edge( xs, x ) ) < dist( edge( b, x ) ) )
+        {
+          edge( b, x ) = edge( xs, x );
+          edge( x, b ) = edge( x, xs );
+        }
+      }
+      for( uint x = 1; x <= n; x++ )
+      {
+        if( from( xs, x ) != 0 )
+          from( b, x ) = xs;
+      }
+    }
+    set_slack( b );
+  }
+
+  /**
+   * Expand an inner blossom whose label has reached zero
+   */
+  void expand_blossom( uint b )
+  {
+    for( uint inner : flower[ b ] )
+    {
+      set_st( inner, inner );
+    }
+    uint xr = from( b, edge( b, pa[ b ] ).u );
+    uint pr = get_pr( b, xr );
+    for( uint i = 0; i < pr; i += 2 )
+    {
+      uint xs = flower[ b ][ i ];
+      uint xns = flower[ b ][ i + 1 ];
+      pa[ xs ] = edge( xns, xs ).u;
+      S[ xs ] = 1;
+      S[ xns ] = 0;
+      slack[ xs ] = 0;
+      set_slack( xns );
+      push( xns );
+    }
+    S[ xr ] = 1;
+    pa[ xr ] = pa[ b ];
+    for( size_t i = pr + 1; i < flower[ b ].size(); i++ )
+    {
+      uint xs = flower[ b ][ i ];
+      S[ xs ] = -1;
+      set_slack( xs );
+    }
+    st[ b ] = 0;
+  }
+
+  /**
+   * Follow a tight edge out of the forest
+   * @return true if it completed an augmenting path
+   */
+  bool on_found_edge( const Link & e )
+  {
+    uint u = st[ e.u ];
+    uint v = st[ e.v ];
+    if( S[ v ] == -1 )
+    {
+      pa[ v ] = e.u;
+      S[ v ] = 1;
+      uint nu = st[ match[ v ] ];
+      slack[ v ] = 0;
+      slack[ nu ] = 0;
+      S[ nu ] = 0;
+      push( nu );
+    }
+    else if( S[ v ] == 0 )
+    {
+      uint lca = get_lca( u, v );
+      if( lca == 0 )
+      {
+        augment( u, v );
+        augment( v, u );
+        return true;
+      }
+      add_blossom( u, lca, v );
+    }
+    return false;
+  }
+
+  /**
+   * Grow the forest and move the labels until one augmentation is made
+   * @return false if the matching is already maximum
+   */
+  bool augmenting_path()
+  {
+    std::fill( S.begin() + 1, S.begin() + n_x + 1, -1 );
+    std::fill( slack.begin() + 1, slack.begin() + n_x + 1, 0 );
+    queue.clear();
+    for( uint x = 1; x <= n_x; x++ )
+    {
+      if( st[ x ] == x && match[ x ] == 0 )
+      {
+        pa[ x ] = 0;
+        S[ x ] = 0;
+        push( x );
+      }
+    }
+    if( queue.empty() )
+      return false;
+
+    while( true )
+    {
+      while( !queue.empty() )
+      {
+        uint u = queue.front();
+        queue.pop_front();
+        if( S[ st[ u ] ] == 1 )
+          continue;
+        for( uint v = 1; v <= n; v++ )
+        {
+          op_count++;
+          if( edge( u, v ).w > 0 && st[ u ] != st[ v ] )
+          {
+            if( dist( edge( u, v ) ) == 0 )
+            {
+              if( on_found_edge( edge( u, v ) ) )
+                return true;
+            }
+            else
+            {
+              update_slack( u, st[ v ] );
+            }
+          }
+        }
+      }
+
+      int64_t d = INF;
+      for( uint b = n + 1; b <= n_x; b++ )
+      {
+        if( st[ b ] == b && S[ b ] == 1 )
+          d = std::min( d, label[ b ] / 2 );
+      }
+      for( uint x = 1; x <= n_x; x++ )
+      {
+        if( st[ x ] == x && slack[ x ] != 0 )
+        {
+          if( S[ x ] == -1 )
+            d = std::min( d, dist( edge( slack[ x ], x ) ) );
+          else if( S[ x ] == 0 )
+            d = std::min( d, dist( edge( slack[ x ], x ) ) / 2 );
+        }
+      }
+      // an outer label would reach zero first: no augmenting path left
+      for( uint u = 1; u <= n; u++ )
+      {
+        if( S[ st[ u ] ] == 0 && label[ u ] <= d )
+          return false;
+      }
+      for( uint u = 1; u <= n; u++ )
+      {
+        if( S[ st[ u ] ] == 0 )
+          label[ u ] -= d;
+        else if( S[ st[ u ] ] == 1 )
+          label[ u ] += d;
+      }
+      for( uint b = n + 1; b <= n_x; b++ )
+      {
+        if( st[ b ] == b )
+        {
+          if( S[ st[ b ] ] == 0 )
+            label[ b ] += d * 2;
+          else if( S[ st[ b ] ] == 1 )
+            label[ b ] -= d * 2;
+        }
+      }
+
+      queue.clear();
+      for( uint x = 1; x <= n_x; x++ )
+      {
+        if( st[ x ] == x && slack[ x ] != 0 && st[ slack[ x ] ] != x
+            && dist( edge( slack[ x ], x ) ) == 0 )
+        {
+          if( on_found_edge( edge( slack[ x ], x ) ) )
+            return true;
+        }
+      }
+      for( uint b = n + 1; b <= n_x; b++ )
+      {
+        if( st[ b ] == b && S[ b ] == 1 && label[ b ] == 0 )
+          expand_blossom( b );
+      }
+    }
+  }
+};
+
+#endif